@@ -0,0 +1,165 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "arbiter.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <algorithm>
+#include <tuple>
+
+namespace phosphor
+{
+namespace led
+{
+
+void Arbiter::request(Physical& led, const std::string& client,
+                      uint8_t priority, Action action)
+{
+    // Only disconnects are of interest, i.e. names losing their owner
+    if (!ownerMatch)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+        ownerMatch.emplace(bus, rules::nameOwnerChanged() + rules::argN(2, ""),
+                           [this](sdbusplus::message_t& m) {
+                               releaseAll(m.unpack<std::string>());
+                           });
+    }
+
+    auto [it, inserted] = tables.try_emplace(&led, Table{{}, led.state()});
+    auto& table = it->second;
+
+    auto entry = std::ranges::find_if(table.requests, [&](const auto& r) {
+        return r.client == client && r.priority == priority;
+    });
+    if (entry != table.requests.end())
+    {
+        entry->action = action;
+        entry->sequence = ++sequence;
+    }
+    else
+    {
+        table.requests.emplace_back(client, priority, action, ++sequence);
+
+        auto& leds = clients[client];
+        if (std::ranges::find(leds, &led) == leds.end())
+        {
+            leds.emplace_back(&led);
+        }
+    }
+
+    apply(led, getEffective(table));
+}
+
+bool Arbiter::release(Physical& led, const std::string& client,
+                      uint8_t priority)
+{
+    auto withdrawn = withdraw(led, client, [priority](const Request& r) {
+        return r.priority == priority;
+    });
+    if (withdrawn == 0)
+    {
+        return false;
+    }
+
+    // Forget the LED for the client once it holds no request for it
+    auto it = tables.find(&led);
+    bool holding = it != tables.end() &&
+                   std::ranges::any_of(it->second.requests,
+                                       [&client](const Request& r) {
+                                           return r.client == client;
+                                       });
+    if (!holding)
+    {
+        auto owner = clients.find(client);
+        std::erase(owner->second, &led);
+        if (owner->second.empty())
+        {
+            clients.erase(owner);
+        }
+    }
+
+    return true;
+}
+
+auto Arbiter::direct(Physical& led, Action action) -> Action
+{
+    auto it = tables.find(&led);
+    if (it == tables.end())
+    {
+        return led.setState(action);
+    }
+
+    it->second.baseline = action;
+
+    return led.state();
+}
+
+void Arbiter::releaseAll(const std::string& client)
+{
+    auto owner = clients.find(client);
+    if (owner == clients.end())
+    {
+        return;
+    }
+
+    auto leds = std::move(owner->second);
+    clients.erase(owner);
+
+    lg2::debug("Releasing the LED requests of {CLIENT}", "CLIENT", client);
+
+    for (auto* led : leds)
+    {
+        withdraw(*led, client, [](const Request&) { return true; });
+    }
+}
+
+auto Arbiter::getEffective(const Table& table) -> Action
+{
+    auto winner = std::ranges::max_element(
+        table.requests, {}, [](const Request& r) {
+            return std::tuple(r.priority, r.sequence);
+        });
+
+    return winner == table.requests.end() ? table.baseline : winner->action;
+}
+
+size_t Arbiter::withdraw(Physical& led, const std::string& client,
+                         const std::function<bool(const Request&)>& predicate)
+{
+    auto it = tables.find(&led);
+    if (it == tables.end())
+    {
+        return 0;
+    }
+
+    auto& table = it->second;
+    auto withdrawn = std::erase_if(table.requests, [&](const Request& r) {
+        return r.client == client && predicate(r);
+    });
+    auto after = getEffective(table);
+
+    if (table.requests.empty())
+    {
+        tables.erase(it);
+    }
+
+    apply(led, after);
+
+    return withdrawn;
+}
+
+void Arbiter::apply(Physical& led, Action action)
+{
+    // Competing requests for the same State never touch the LED
+    if (led.state() == action)
+    {
+        return;
+    }
+
+    led.setState(action);
+}
+
+} // namespace led
+} // namespace phosphor
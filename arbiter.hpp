@@ -0,0 +1,149 @@
+#pragma once
+
+#include "physical.hpp"
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/match.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace phosphor
+{
+namespace led
+{
+
+/** @class Arbiter
+ *  @brief Decides between the State requests of several clients
+ *
+ *  Each client may request a State for an LED at any number of priorities.
+ *  The request of the highest priority wins, among equal priorities the
+ *  latest. The LED is only written when it is not in the winning State.
+ *  State set directly, on the bus or a peer connection, is the request of
+ *  the lowest priority: it only shows while nobody else requests, and the
+ *  LED returns to it once the last request is withdrawn. Requests of a
+ *  client are withdrawn when it leaves the bus, they can only be made on
+ *  the bus as peer connections do not serve the Arbitration interface.
+ */
+class Arbiter
+{
+  public:
+    Arbiter() = delete;
+    ~Arbiter() = default;
+    Arbiter(const Arbiter&) = delete;
+    Arbiter& operator=(const Arbiter&) = delete;
+    Arbiter(Arbiter&&) = delete;
+    Arbiter& operator=(Arbiter&&) = delete;
+
+    using Action =
+        sdbusplus::xyz::openbmc_project::Led::server::Physical::Action;
+
+    /** @brief Constructs the arbiter
+     *
+     *  @param[in] bus - bus the clients are connected to
+     */
+    explicit Arbiter(sdbusplus::bus_t& bus) : bus(bus) {}
+
+    /** @brief Adds or replaces the request of a client at a priority
+     *
+     *  @param[in] led      - the LED
+     *  @param[in] client   - unique bus name of the client
+     *  @param[in] priority - priority of the request, higher wins
+     *  @param[in] action   - the requested State
+     */
+    void request(Physical& led, const std::string& client, uint8_t priority,
+                 Action action);
+
+    /** @brief Withdraws the request of a client at a priority
+     *
+     *  @param[in] led      - the LED
+     *  @param[in] client   - unique bus name of the client
+     *  @param[in] priority - priority of the request
+     *  @return false if there was no such request
+     */
+    bool release(Physical& led, const std::string& client, uint8_t priority);
+
+    /** @brief Sets State of an LED directly
+     *
+     *  Applied right away unless there are requests for the LED, then it
+     *  is kept for when they are withdrawn.
+     *
+     *  @param[in] led    - the LED
+     *  @param[in] action - the State
+     *  @return the State of the LED
+     */
+    Action direct(Physical& led, Action action);
+
+    /** @brief Withdraws all requests of a client
+     *
+     *  @param[in] client - unique bus name of the client
+     */
+    void releaseAll(const std::string& client);
+
+  private:
+    /** @brief One request of a client */
+    struct Request
+    {
+        std::string client;
+        uint8_t priority;
+        Action action;
+
+        /** @brief Order of the requests, the latest wins a tie */
+        uint64_t sequence;
+    };
+
+    /** @brief Requests for one LED */
+    struct Table
+    {
+        std::vector<Request> requests;
+
+        /** @brief State last set directly, or the State of the LED before
+         *   the first request
+         */
+        Action baseline;
+    };
+
+    /** @brief Bus the clients are connected to */
+    sdbusplus::bus_t& bus;
+
+    /** @brief Requests by LED, only LEDs with requests have one */
+    std::map<Physical*, Table> tables;
+
+    /** @brief LEDs requested by a client */
+    std::map<std::string, std::vector<Physical*>, std::less<>> clients;
+
+    /** @brief Source of Request::sequence */
+    uint64_t sequence = 0;
+
+    /** @brief Match of clients leaving the bus, added on first use */
+    std::optional<sdbusplus::bus::match_t> ownerMatch;
+
+    /** @brief State of the LED the requests make for */
+    static Action getEffective(const Table& table);
+
+    /** @brief Withdraws the requests of a client for an LED matching a
+     *   predicate
+     *
+     *  @param[in] led       - the LED
+     *  @param[in] client    - unique bus name of the client
+     *  @param[in] predicate - selects the requests to withdraw
+     *  @return the number of withdrawn requests
+     */
+    size_t withdraw(Physical& led, const std::string& client,
+                    const std::function<bool(const Request&)>& predicate);
+
+    /** @brief Applies the State the requests make for if the LED is not
+     *   in it, e.g. after a lamp test
+     *
+     *  @param[in] led    - the LED
+     *  @param[in] action - State the requests make for
+     */
+    static void apply(Physical& led, Action action);
+};
+
+} // namespace led
+} // namespace phosphor
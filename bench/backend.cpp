@@ -0,0 +1,167 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "led_backend.hpp"
+#include "sysfs.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace phosphor::led;
+
+static constexpr size_t ledCount = 100;
+static constexpr size_t iterations = 1000;
+
+/** @brief Backend kept in memory, so only the write sequences are
+ *  measured
+ */
+class MemoryLed
+{
+  public:
+    int setBrightness(unsigned long value)
+    {
+        brightness = value;
+        return 0;
+    }
+    int setTrigger(const std::string& value)
+    {
+        timer = value == "timer";
+        return 0;
+    }
+    int setTriggerAttr(const std::string& /*attr*/,
+                       const std::string& /*value*/)
+    {
+        return 0;
+    }
+    int setDelayOn(unsigned long ms)
+    {
+        delayOn = ms;
+        return 0;
+    }
+    int setDelayOff(unsigned long ms)
+    {
+        delayOff = ms;
+        return 0;
+    }
+
+    unsigned long brightness = 0;
+    unsigned long delayOn = 0;
+    unsigned long delayOff = 0;
+    bool timer = false;
+};
+
+static_assert(LedBackend<MemoryLed>);
+
+/** @brief Steps all LEDs through On, Blink and Off
+ *
+ *  @param[in] leds  - the LEDs
+ *  @param[in] write - runs a sequence on an LED, the way Physical does
+ */
+template <typename Led, typename Write>
+static std::chrono::nanoseconds transitions(const std::vector<Led*>& leds,
+                                            Write&& write)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++)
+    {
+        for (auto* led : leds)
+        {
+            switch (i % 3)
+            {
+                case 0:
+                    write(*led, [](auto& backend) {
+                        return writeSteady(backend, 255);
+                    });
+                    break;
+                case 1:
+                    write(*led, [](auto& backend) {
+                        return writeBlink(backend, 500, 500, std::nullopt);
+                    });
+                    break;
+                default:
+                    write(*led, [](auto& backend) {
+                        return writeSteady(backend, 0);
+                    });
+                    break;
+            }
+        }
+    }
+
+    return std::chrono::steady_clock::now() - start;
+}
+
+static void report(const char* name, std::chrono::nanoseconds elapsed)
+{
+    std::cout << "State transitions, " << ledCount << " LEDs, " << name
+              << ": " << elapsed.count() / (ledCount * iterations)
+              << " ns/transition\n";
+}
+
+int main()
+{
+    std::vector<std::unique_ptr<MemoryLed>> memory;
+    std::vector<MemoryLed*> memoryLeds;
+    for (size_t i = 0; i < ledCount; i++)
+    {
+        memoryLeds.emplace_back(
+            memory.emplace_back(std::make_unique<MemoryLed>()).get());
+    }
+
+    // The sysfs LEDs are plain files, e.g. on tmpfs, so the writes are
+    // real system calls without the driver behind them
+    char pattern[] = "/tmp/bench-backend-XXXXXX";
+    if (mkdtemp(pattern) == nullptr)
+    {
+        std::cerr << "Unable to create the LED tree\n";
+        return 1;
+    }
+    std::filesystem::path tree(pattern);
+
+    std::vector<std::unique_ptr<SysfsLed>> sysfs;
+    std::vector<SysfsLed*> sysfsLeds;
+    for (size_t i = 0; i < ledCount; i++)
+    {
+        auto root = tree / ("led" + std::to_string(i));
+        std::filesystem::create_directory(root);
+        std::ofstream(root / "brightness") << "0";
+        auto* led =
+            sysfs.emplace_back(std::make_unique<SysfsLed>(std::move(root)))
+                .get();
+        sysfsLeds.emplace_back(led);
+    }
+
+    report("memory backend, sequences only",
+           transitions(memoryLeds,
+                       [](MemoryLed& led, auto&& seq) { return seq(led); }));
+
+    // The virtual calls through SysfsLed, as Physical makes them
+    report("sysfs, virtual calls",
+           transitions(sysfsLeds,
+                       [](SysfsLed& led, auto&& seq) { return seq(led); }));
+
+    // Checking the writes also keeps them from being optimized out
+    bool ok = true;
+    for (const auto& led : memory)
+    {
+        ok = ok && led->brightness == 255 && !led->timer;
+    }
+    for (const auto& led : sysfs)
+    {
+        ok = ok && led->getBrightness() == 255;
+    }
+    std::filesystem::remove_all(tree);
+    if (!ok)
+    {
+        std::cerr << "Unexpected LED state\n";
+        return 1;
+    }
+
+    return 0;
+}
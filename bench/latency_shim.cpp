@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+/* Preloaded into the controller by the startup benchmark. Opening a file
+ * below LED_BENCH_ROOT takes LED_BENCH_LATENCY_US longer, like reading an
+ * attribute of an LED behind a slow bus.
+ */
+
+// The fortified open() is an inline wrapper that would clash with ours
+#undef _FORTIFY_SOURCE
+
+#include <dlfcn.h>
+#include <fcntl.h>
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include <thread>
+
+namespace
+{
+
+void delay(const char* path)
+{
+    static const char* root = std::getenv("LED_BENCH_ROOT");
+    static const auto latency = [] {
+        const char* value = std::getenv("LED_BENCH_LATENCY_US");
+        return std::chrono::microseconds(
+            value == nullptr ? 0 : std::strtoul(value, nullptr, 10));
+    }();
+
+    if (root == nullptr || path == nullptr || latency.count() == 0)
+    {
+        return;
+    }
+
+    if (std::string_view(path).starts_with(root))
+    {
+        std::this_thread::sleep_for(latency);
+    }
+}
+
+template <typename Function>
+Function next(const char* name)
+{
+    return reinterpret_cast<Function>(dlsym(RTLD_NEXT, name));
+}
+
+mode_t getMode(int flags, va_list args)
+{
+    if ((flags & O_CREAT) != 0 || (flags & O_TMPFILE) == O_TMPFILE)
+    {
+        return va_arg(args, mode_t);
+    }
+
+    return 0;
+}
+
+} // namespace
+
+extern "C"
+{
+
+int open(const char* path, int flags, ...)
+{
+    va_list args;
+    va_start(args, flags);
+    auto mode = getMode(flags, args);
+    va_end(args);
+
+    delay(path);
+    static auto real = next<int (*)(const char*, int, ...)>("open");
+    return real(path, flags, mode);
+}
+
+int open64(const char* path, int flags, ...)
+{
+    va_list args;
+    va_start(args, flags);
+    auto mode = getMode(flags, args);
+    va_end(args);
+
+    delay(path);
+    static auto real = next<int (*)(const char*, int, ...)>("open64");
+    return real(path, flags, mode);
+}
+
+int openat(int dirfd, const char* path, int flags, ...)
+{
+    va_list args;
+    va_start(args, flags);
+    auto mode = getMode(flags, args);
+    va_end(args);
+
+    delay(path);
+    static auto real = next<int (*)(int, const char*, int, ...)>("openat");
+    return real(dirfd, path, flags, mode);
+}
+
+FILE* fopen(const char* path, const char* mode)
+{
+    delay(path);
+    static auto real = next<FILE* (*)(const char*, const char*)>("fopen");
+    return real(path, mode);
+}
+
+FILE* fopen64(const char* path, const char* mode)
+{
+    delay(path);
+    static auto real = next<FILE* (*)(const char*, const char*)>("fopen64");
+    return real(path, mode);
+}
+}
@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "interfaces/internal_interface.hpp"
+#include "interfaces/object_manager.hpp"
+#include "physical.hpp"
+
+#include <sdbusplus/bus.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace phosphor::led;
+using namespace phosphor::led::sysfs::interface;
+
+static constexpr auto benchPath = "/xyz/openbmc_project/led";
+static constexpr size_t ledCount = 1000;
+static constexpr size_t iterations = 100;
+
+/** @brief LED without any I/O, so only D-Bus costs are measured */
+class NullLed : public SysfsLed
+{
+  public:
+    NullLed() : SysfsLed(fs::path(devParent) / "bench") {}
+
+    unsigned long getBrightness() override
+    {
+        return 0;
+    }
+    int setBrightness(unsigned long /*brightness*/) override
+    {
+        return 0;
+    }
+    unsigned long getMaxBrightness() override
+    {
+        return 255;
+    }
+    std::string getTrigger() override
+    {
+        return "none";
+    }
+    std::vector<std::string> getTriggers() override
+    {
+        return {"none", "timer"};
+    }
+    int setTrigger(const std::string& /*trigger*/) override
+    {
+        return 0;
+    }
+    int setTriggerAttr(const std::string& /*attr*/,
+                       const std::string& /*value*/) override
+    {
+        return 0;
+    }
+    unsigned long getDelayOn() override
+    {
+        return 0;
+    }
+    int setDelayOn(unsigned long /*ms*/) override
+    {
+        return 0;
+    }
+    unsigned long getDelayOff() override
+    {
+        return 0;
+    }
+    int setDelayOff(unsigned long /*ms*/) override
+    {
+        return 0;
+    }
+};
+
+static void run(bool cache)
+{
+    auto server = sdbusplus::bus::new_default();
+    auto client = sdbusplus::bus::new_default();
+
+    ObjectManager objManager(server, benchPath, cache);
+
+    std::vector<std::unique_ptr<Physical>> leds;
+    leds.reserve(ledCount);
+    for (size_t i = 0; i < ledCount; i++)
+    {
+        auto path = std::string(physParent) + "/bench" + std::to_string(i);
+        auto& led = *leds.emplace_back(std::make_unique<Physical>(
+            server, path, std::make_unique<NullLed>(), "", true));
+        objManager.add(path, {{physicalInterface,
+                               [&led](sdbusplus::message_t& m) {
+                                   m.append(
+                                       InternalInterface::getProperties(led));
+                               }}});
+    }
+
+    // The bus belongs to the dispatcher once it runs
+    auto service = server.get_unique_name();
+
+    std::atomic<bool> done = false;
+    std::thread dispatcher([&server, &done]() {
+        while (!done)
+        {
+            server.process_discard();
+            server.wait(std::chrono::milliseconds(10));
+        }
+    });
+
+    auto call = [&client, &service]() {
+        auto method = client.new_method_call(
+            service.c_str(), benchPath, "org.freedesktop.DBus.ObjectManager",
+            "GetManagedObjects");
+        client.call(method);
+    };
+
+    // The first call fills the cache
+    call();
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++)
+    {
+        call();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    done = true;
+    dispatcher.join();
+
+    auto us =
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    std::cout << "GetManagedObjects, " << ledCount << " LEDs, "
+              << (cache ? "cached" : "uncached") << ": "
+              << us / static_cast<long>(iterations) << " us/call\n";
+}
+
+int main()
+{
+    run(false);
+    run(true);
+
+    return 0;
+}
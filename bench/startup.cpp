@@ -0,0 +1,270 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "interfaces/internal_interface.hpp"
+
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+
+#include <nlohmann/json.hpp>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+extern char** environ;
+
+namespace fs = std::filesystem;
+using Clock = std::chrono::steady_clock;
+
+static constexpr std::array<size_t, 4> ledCounts = {10, 100, 1000, 5000};
+
+/** @brief Latency added to every open of an LED attribute */
+static constexpr std::array<unsigned, 2> latencies = {0, 200};
+
+static constexpr auto timeout = std::chrono::seconds(120);
+
+/** @brief Creates the class directories of count LEDs below dir */
+static fs::path makeTree(const fs::path& dir, size_t count)
+{
+    auto root = dir / "leds";
+    for (size_t i = 0; i < count; i++)
+    {
+        auto led = root / ("bench:green:led" + std::to_string(i));
+        fs::create_directories(led);
+        std::ofstream(led / "brightness") << "0\n";
+        std::ofstream(led / "max_brightness") << "255\n";
+        std::ofstream(led / "trigger") << "[none] timer\n";
+    }
+
+    return root;
+}
+
+/** @brief Starts a process with extra environment variables */
+static pid_t spawn(const std::vector<std::string>& args,
+                   const std::vector<std::string>& env)
+{
+    std::vector<char*> argv;
+    for (const auto& arg : args)
+    {
+        argv.emplace_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.emplace_back(nullptr);
+
+    std::vector<char*> envp;
+    for (auto** var = environ; *var != nullptr; ++var)
+    {
+        envp.emplace_back(*var);
+    }
+    for (const auto& var : env)
+    {
+        envp.emplace_back(const_cast<char*>(var.c_str()));
+    }
+    envp.emplace_back(nullptr);
+
+    pid_t pid = 0;
+    auto rc = posix_spawnp(&pid, argv[0], nullptr, nullptr, argv.data(),
+                           envp.data());
+    if (rc != 0)
+    {
+        throw std::system_error(rc, std::generic_category(), args[0]);
+    }
+
+    return pid;
+}
+
+static void stop(pid_t pid)
+{
+    kill(pid, SIGTERM);
+    waitpid(pid, nullptr, 0);
+}
+
+/** @brief Milliseconds from start to a point in time, null if none */
+static nlohmann::json since(Clock::time_point start,
+                            std::optional<Clock::time_point> point)
+{
+    if (!point)
+    {
+        return nullptr;
+    }
+
+    return std::chrono::duration<double, std::milli>(*point - start).count();
+}
+
+/** @brief Names of the LEDs the controller lists */
+static std::vector<std::string> enumerate(sdbusplus::bus_t& bus)
+{
+    auto m = bus.new_method_call(busName, physParent,
+                                 "org.freedesktop.DBus.Introspectable",
+                                 "Introspect");
+    auto xml = bus.call(m).unpack<std::string>();
+
+    static constexpr std::string_view node = "<node name=\"";
+    std::vector<std::string> names;
+    for (auto pos = xml.find(node); pos != std::string::npos;
+         pos = xml.find(node, pos))
+    {
+        pos += node.size();
+        auto end = xml.find('"', pos);
+        names.emplace_back(xml.substr(pos, end - pos));
+    }
+
+    return names;
+}
+
+static nlohmann::json run(const std::string& controller,
+                          const std::string& shim, size_t count,
+                          unsigned latency)
+{
+    std::string tmplt = "/tmp/StartupBench.XXXXXX";
+    fs::path dir = mkdtemp(tmplt.data());
+    auto root = makeTree(dir, count);
+
+    // A private bus, so the LEDs of the host are not disturbed
+    auto socket = dir / "bus";
+    auto address = "unix:path=" + socket.string();
+    auto daemon = spawn({"dbus-daemon", "--session", "--nofork",
+                         "--address=" + address},
+                        {});
+    auto launched = Clock::now();
+    while (!fs::exists(socket))
+    {
+        if (Clock::now() - launched > timeout)
+        {
+            stop(daemon);
+            fs::remove_all(dir);
+            throw std::runtime_error("dbus-daemon did not start");
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    setenv("DBUS_SYSTEM_BUS_ADDRESS", address.c_str(), 1);
+    auto bus = sdbusplus::bus::new_system();
+
+    std::optional<Clock::time_point> named;
+    namespace rules = sdbusplus::bus::match::rules;
+    sdbusplus::bus::match_t owner(
+        bus, rules::nameOwnerChanged(busName),
+        [&named](sdbusplus::message_t& m) {
+            auto [name, before, after] =
+                m.unpack<std::string, std::string, std::string>();
+            if (!after.empty() && !named)
+            {
+                named = Clock::now();
+            }
+        });
+
+    // Publication time of each LED. The match takes any sender, as the
+    // LEDs published before the name is owned come from the unique name.
+    std::map<std::string, Clock::time_point> published;
+    std::string prefix = std::string(physParent) + "/";
+    sdbusplus::bus::match_t added(
+        bus, rules::interfacesAdded(ledPath),
+        [&published, &prefix](sdbusplus::message_t& m) {
+            auto path = m.unpack<sdbusplus::message::object_path>().str;
+            if (path.starts_with(prefix))
+            {
+                published.try_emplace(path, Clock::now());
+            }
+        });
+
+    std::vector<std::string> env = {
+        "DBUS_SYSTEM_BUS_ADDRESS=" + address,
+        "DBUS_STARTER_BUS_TYPE=system",
+    };
+    if (latency != 0 && !shim.empty())
+    {
+        env.emplace_back("LD_PRELOAD=" + shim);
+        env.emplace_back("LED_BENCH_ROOT=" + root.string());
+        env.emplace_back("LED_BENCH_LATENCY_US=" + std::to_string(latency));
+    }
+
+    auto start = Clock::now();
+    auto pid = spawn({controller, "--sysfs-root", root.string()}, env);
+    auto spawned = Clock::now();
+
+    // LEDs listed once the name is owned but not seen added, e.g. when
+    // a signal was lost, count as published by then
+    std::optional<size_t> listed;
+    while ((!named || published.size() < count) &&
+           Clock::now() - start < timeout)
+    {
+        bus.process_discard();
+        if (named && !listed)
+        {
+            listed = 0;
+            for (const auto& name : enumerate(bus))
+            {
+                published.try_emplace(prefix + name, *named);
+                ++*listed;
+            }
+            continue;
+        }
+        bus.wait(std::chrono::milliseconds(10));
+    }
+
+    std::optional<Clock::time_point> first;
+    std::optional<Clock::time_point> last;
+    for (const auto& [path, time] : published)
+    {
+        first = first ? std::min(*first, time) : time;
+        last = last ? std::max(*last, time) : time;
+    }
+
+    stop(pid);
+    stop(daemon);
+    fs::remove_all(dir);
+
+    return {
+        {"leds", count},
+        {"latencyUs", latency},
+        {"spawnMs", since(start, spawned)},
+        {"nameAcquiredMs", since(start, named)},
+        {"firstLedMs", since(start, first)},
+        {"lastLedMs", since(start, last)},
+        {"ledsPublished", published.size()},
+        {"ledsAtName", listed ? nlohmann::json(*listed) : nullptr},
+    };
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " <phosphor-ledcontroller> [latency shim]\n";
+        return EXIT_FAILURE;
+    }
+
+    std::string controller = argv[1];
+    std::string shim = argc > 2 ? fs::absolute(argv[2]).string() : "";
+
+    nlohmann::json runs = nlohmann::json::array();
+    for (auto latency : latencies)
+    {
+        for (auto count : ledCounts)
+        {
+            runs.emplace_back(run(controller, shim, count, latency));
+        }
+    }
+
+    std::cout << nlohmann::json{{"runs", runs}}.dump(4) << "\n";
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,342 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#pragma once
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
+#include <xyz/openbmc_project/Led/Physical/server.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace phosphor
+{
+namespace led
+{
+namespace client
+{
+
+using Action = sdbusplus::xyz::openbmc_project::Led::server::Physical::Action;
+using PhysicalServer = sdbusplus::xyz::openbmc_project::Led::server::Physical;
+
+constexpr auto service = "xyz.openbmc_project.LED.Controller";
+constexpr auto controllerPath = "/xyz/openbmc_project/led";
+constexpr auto physicalRoot = "/xyz/openbmc_project/led/physical";
+constexpr auto internalInterface = "xyz.openbmc_project.Led.Sysfs.Internal";
+constexpr auto setStatesMethod = "SetStates";
+constexpr auto physicalInterface = "xyz.openbmc_project.Led.Physical";
+
+/** @brief Values of the xyz.openbmc_project.Led.Physical properties */
+using PropertyValue = std::variant<std::string, uint8_t, uint16_t>;
+using PropertyMap = std::map<std::string, PropertyValue>;
+
+class Controller;
+
+/** @class Led
+ *  @brief Proxy of an LED caching its properties
+ *
+ *  The properties are read once when the proxy is created and kept up to
+ *  date from PropertiesChanged by the Controller. Setting a property to
+ *  its cached value sends nothing. Only a Controller creates proxies, its
+ *  match is what keeps them up to date.
+ */
+class Led
+{
+  public:
+    Led() = delete;
+    ~Led() = default;
+    Led(const Led&) = delete;
+    Led& operator=(const Led&) = delete;
+    Led(Led&&) = delete;
+    Led& operator=(Led&&) = delete;
+
+    const std::string& getPath() const
+    {
+        return path;
+    }
+
+    Action getState() const
+    {
+        return state;
+    }
+
+    uint8_t getDutyOn() const
+    {
+        return dutyOn;
+    }
+
+    uint16_t getPeriod() const
+    {
+        return period;
+    }
+
+    /** @brief Sets State unless it already is the cached one
+     *
+     *  @return true if the property was set
+     */
+    bool setState(Action value)
+    {
+        if (value == state)
+        {
+            return false;
+        }
+
+        set("State", PhysicalServer::convertActionToString(value));
+        state = value;
+        return true;
+    }
+
+    /** @brief Sets DutyOn unless it already is the cached one
+     *
+     *  @return true if the property was set
+     */
+    bool setDutyOn(uint8_t value)
+    {
+        if (value == dutyOn)
+        {
+            return false;
+        }
+
+        set("DutyOn", value);
+        dutyOn = value;
+        return true;
+    }
+
+    /** @brief Sets Period unless it already is the cached one
+     *
+     *  @return true if the property was set
+     */
+    bool setPeriod(uint16_t value)
+    {
+        if (value == period)
+        {
+            return false;
+        }
+
+        set("Period", value);
+        period = value;
+        return true;
+    }
+
+  private:
+    friend class Controller;
+
+    /** @brief Creates the proxy, reading the properties of the LED
+     *
+     *  @param[in] bus         - bus the controller is on
+     *  @param[in] path        - object path of the LED or group
+     *  @param[in] destination - bus name of the controller
+     */
+    Led(sdbusplus::bus_t& bus, std::string path, std::string destination) :
+        bus(bus), path(std::move(path)), destination(std::move(destination))
+    {
+        auto m = bus.new_method_call(this->destination.c_str(),
+                                     this->path.c_str(),
+                                     "org.freedesktop.DBus.Properties",
+                                     "GetAll");
+        m.append(physicalInterface);
+        update(bus.call(m).unpack<PropertyMap>());
+    }
+
+    /** @brief Updates the cache from a set of properties */
+    void update(const PropertyMap& properties)
+    {
+        for (const auto& [name, value] : properties)
+        {
+            if (name == "State" && std::holds_alternative<std::string>(value))
+            {
+                state = PhysicalServer::convertActionFromString(
+                    std::get<std::string>(value));
+            }
+            else if (name == "DutyOn" && std::holds_alternative<uint8_t>(value))
+            {
+                dutyOn = std::get<uint8_t>(value);
+            }
+            else if (name == "Period" &&
+                     std::holds_alternative<uint16_t>(value))
+            {
+                period = std::get<uint16_t>(value);
+            }
+        }
+    }
+
+    sdbusplus::bus_t& bus;
+    std::string path;
+    std::string destination;
+    Action state = Action::Off;
+    uint8_t dutyOn = 50;
+    uint16_t period = 1000;
+
+    template <typename T>
+    void set(const char* property, const T& value)
+    {
+        auto m = bus.new_method_call(destination.c_str(), path.c_str(),
+                                     "org.freedesktop.DBus.Properties",
+                                     "Set");
+        m.append(physicalInterface, property, std::variant<T>(value));
+        bus.call(m);
+    }
+};
+
+/** @class Controller
+ *  @brief Proxies of the LEDs of the LED controller
+ *
+ *  A single match keeps all proxies up to date. Proxies are created on
+ *  first use and live as long as the controller.
+ */
+class Controller
+{
+  public:
+    Controller() = delete;
+    ~Controller() = default;
+    Controller(const Controller&) = delete;
+    Controller& operator=(const Controller&) = delete;
+    Controller(Controller&&) = delete;
+    Controller& operator=(Controller&&) = delete;
+
+    /** @class Batch
+     *  @brief Collects State changes and sends them in a single call
+     *
+     *  A later State of the same LED replaces an earlier one. LEDs with
+     *  a proxy already in that State are left out, a batch with nothing
+     *  left sends nothing. SetStates only takes State, DutyOn and Period
+     *  are set through the proxy of each LED.
+     */
+    class Batch
+    {
+      public:
+        explicit Batch(Controller& controller) : controller(controller) {}
+
+        /** @brief Adds the State of an LED or group
+         *
+         *  @param[in] path  - object path of the LED or group
+         *  @param[in] value - the State
+         */
+        Batch& setState(const std::string& path, Action value)
+        {
+            states.insert_or_assign(path, value);
+            return *this;
+        }
+
+        /** @brief Sends the collected States
+         *
+         *  @return the number of LEDs and groups sent
+         */
+        size_t commit()
+        {
+            std::map<sdbusplus::message::object_path, std::string> changed;
+            for (const auto& [path, value] : states)
+            {
+                auto* led = controller.find(path);
+                if (led == nullptr || led->getState() != value)
+                {
+                    changed.emplace(
+                        path, PhysicalServer::convertActionToString(value));
+                }
+            }
+            states.clear();
+
+            if (changed.empty())
+            {
+                return 0;
+            }
+
+            auto m = controller.bus.new_method_call(
+                controller.destination.c_str(), controllerPath,
+                internalInterface, setStatesMethod);
+            m.append(changed);
+            controller.bus.call(m);
+
+            for (const auto& [path, value] : changed)
+            {
+                auto* led = controller.find(path.str);
+                if (led != nullptr)
+                {
+                    led->update({{"State", value}});
+                }
+            }
+
+            return changed.size();
+        }
+
+      private:
+        Controller& controller;
+        std::map<std::string, Action> states;
+    };
+
+    /** @brief Starts following the property changes of all LEDs
+     *
+     *  @param[in] bus         - bus the controller is on
+     *  @param[in] destination - bus name of the controller
+     */
+    explicit Controller(sdbusplus::bus_t& bus,
+                        std::string destination = service) :
+        bus(bus), destination(std::move(destination)),
+        match(bus,
+              sdbusplus::bus::match::rules::propertiesChangedNamespace(
+                  physicalRoot, physicalInterface),
+              [this](sdbusplus::message_t& m) { changed(m); })
+    {}
+
+    /** @brief The proxy of an LED or group, created on first use
+     *
+     *  @param[in] path - object path of the LED or group
+     */
+    Led& get(const std::string& path)
+    {
+        auto it = leds.find(path);
+        if (it == leds.end())
+        {
+            // The constructor is private, make_unique cannot call it
+            std::unique_ptr<Led> led(new Led(bus, path, destination));
+            it = leds.emplace(path, std::move(led)).first;
+        }
+
+        return *it->second;
+    }
+
+    /** @brief The proxy of an LED or group, nullptr if none was created */
+    Led* find(std::string_view path)
+    {
+        auto it = leds.find(path);
+        return it == leds.end() ? nullptr : it->second.get();
+    }
+
+    /** @brief Starts a batch of State changes */
+    Batch batch()
+    {
+        return Batch(*this);
+    }
+
+  private:
+    sdbusplus::bus_t& bus;
+    std::string destination;
+    std::map<std::string, std::unique_ptr<Led>, std::less<>> leds;
+    sdbusplus::bus::match_t match;
+
+    void changed(sdbusplus::message_t& m)
+    {
+        auto* led = find(m.get_path());
+        if (led == nullptr)
+        {
+            return;
+        }
+
+        auto [interface, properties, invalidated] =
+            m.unpack<std::string, PropertyMap, std::vector<std::string>>();
+        led->update(properties);
+    }
+};
+
+} // namespace client
+} // namespace led
+} // namespace phosphor
@@ -15,26 +15,57 @@
  */
 
 #include "interfaces/internal_interface.hpp"
+#include "interfaces/peer_server.hpp"
 
-int main()
+#include <CLI/CLI.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <optional>
+#include <string>
+
+int main(int argc, char** argv)
 {
-    // Get a handle to system dbus
+    CLI::App app{"Exposes the sysfs LEDs on D-Bus"};
+
+    // Benchmarks run the controller on a synthetic tree of LEDs
+    std::string root = devParent;
+    app.add_option("--sysfs-root", root,
+                   "Directory of the LED class devices");
+
+    // High-rate local clients may connect directly, off by default
+    std::string peerSocket;
+    app.add_option("--peer-socket", peerSocket,
+                   "Unix socket serving direct peer connections to root, "
+                   "the controller's user and the socket's group");
+    CLI11_PARSE(app, argc, argv);
+
+    // Get a handle to the event loop and to system dbus
+    auto event = sdeventplus::Event::get_default();
     auto bus = sdbusplus::bus::new_default();
+    bus.attach_event(event.get(), SD_EVENT_PRIORITY_NORMAL);
 
-    // Add the ObjectManager interface
-    sdbusplus::server::manager_t objManager(bus, ledPath);
+    // Create an led controller object, it also hosts the ObjectManager
+    phosphor::led::sysfs::interface::InternalInterface internal(bus, ledPath,
+                                                                event, root);
 
-    // Create an led controller object
-    phosphor::led::sysfs::interface::InternalInterface internal(bus, ledPath);
+    // Configured LEDs get their objects before the kernel enumerates them,
+    // their sysfs devices are bound as they appear
+    internal.preregisterLEDs(
+        phosphor::led::LedConfig::load(defaultConfigPath));
 
-    // Request service bus name
-    bus.request_name(busName);
+    // Register the LEDs sysfs already knows about in one go, before the
+    // name is owned nobody has to be told about them
+    internal.scanLEDs();
 
-    while (true)
+    std::optional<phosphor::led::sysfs::interface::PeerServer> peers;
+    if (!peerSocket.empty())
     {
-        // Handle dbus message / signals discarding unhandled
-        bus.process_discard();
-        bus.wait();
+        peers.emplace(event, peerSocket, internal);
     }
-    return 0;
+
+    // Request service bus name
+    bus.request_name(busName);
+
+    // Handle dbus messages and timers, timing how long each blocks the loop
+    return internal.loop();
 }
@@ -0,0 +1,203 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "frame_scheduler.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+namespace phosphor
+{
+namespace led
+{
+
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+
+FrameScheduler::FrameScheduler(const sdeventplus::Event& event,
+                               unsigned budget) :
+    clock(event), timer(event, [this](auto&) { tick(); }),
+    budget(duration_cast<microseconds>(std::chrono::seconds(1)) * budget /
+           1000)
+{
+    timer.setEnabled(false);
+}
+
+void FrameScheduler::start(const void* owner, Fade fade)
+{
+    auto now = clock.now();
+    auto interval = getInterval(owner, fade);
+
+    // The first frame is always written
+    auto& state = fades
+                      .insert_or_assign(
+                          owner, State{std::move(fade), now, now, interval,
+                                       std::numeric_limits<unsigned long>::max()})
+                      .first->second;
+
+    if (!advance(owner, state, now, getStretch()))
+    {
+        fades.erase(owner);
+    }
+
+    schedule();
+}
+
+void FrameScheduler::stop(const void* owner)
+{
+    if (fades.erase(owner) != 0U)
+    {
+        schedule();
+    }
+}
+
+void FrameScheduler::forget(const void* owner)
+{
+    stop(owner);
+    costs.erase(owner);
+}
+
+unsigned long FrameScheduler::getValue(const State& state,
+                                       Clock::time_point now)
+{
+    const auto& fade = state.fade;
+    const auto& table = *fade.table;
+
+    auto elapsed = duration_cast<microseconds>(now - state.begin).count();
+    auto duration = duration_cast<microseconds>(fade.duration).count();
+    if (elapsed >= duration)
+    {
+        return table[fade.to];
+    }
+
+    // Interpolate the level in thousandths and the value between the
+    // levels, so slow fades on fine grained LEDs do not stair-step
+    int64_t span = (static_cast<int64_t>(fade.to) - fade.from) * 1000;
+    int64_t position = (fade.from * 1000) + (span * elapsed / duration);
+    auto level = static_cast<size_t>(position / 1000);
+    auto fraction = static_cast<unsigned long>(position % 1000);
+
+    auto value = table[level];
+    if (level < maxLevel)
+    {
+        value += (table[level + 1] - value) * fraction / 1000;
+    }
+
+    return value;
+}
+
+microseconds FrameScheduler::getInterval(const void* owner,
+                                         const Fade& fade) const
+{
+    const auto& table = *fade.table;
+
+    // No point in frames faster than the value can change
+    auto low = std::min(table[fade.from], table[fade.to]);
+    auto high = std::max(table[fade.from], table[fade.to]);
+    auto steps = static_cast<int64_t>(std::max(high - low, 1UL));
+    auto interval = duration_cast<microseconds>(fade.duration) / steps;
+
+    // Slow devices, e.g. behind an I2C expander, get fewer frames
+    auto cost = costs.find(owner);
+    if (cost != costs.end())
+    {
+        interval = std::max<microseconds>(interval, cost->second * deviceShare);
+    }
+
+    return std::clamp<microseconds>(interval, minInterval, maxInterval);
+}
+
+uint64_t FrameScheduler::getStretch() const
+{
+    // Write time per second of all fades at their own frame rates
+    uint64_t load = 0;
+    for (const auto& [owner, state] : fades)
+    {
+        auto cost = costs.find(owner);
+        if (cost != costs.end())
+        {
+            load += cost->second.count() * 1000000 / state.interval.count();
+        }
+    }
+
+    auto allowed = static_cast<uint64_t>(budget.count());
+    if (load <= allowed || allowed == 0)
+    {
+        return 1000;
+    }
+
+    return load * 1000 / allowed;
+}
+
+void FrameScheduler::write(const void* owner, State& state,
+                           unsigned long value)
+{
+    if (value == state.value)
+    {
+        return;
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    state.fade.apply(value);
+    auto cost =
+        duration_cast<microseconds>(std::chrono::steady_clock::now() - begin);
+    state.value = value;
+
+    // Moving average over about the last 8 writes
+    auto& average = costs[owner];
+    average = average == microseconds::zero() ? cost : (average * 7 + cost) / 8;
+    state.interval = getInterval(owner, state.fade);
+}
+
+bool FrameScheduler::advance(const void* owner, State& state,
+                             Clock::time_point now, uint64_t stretch)
+{
+    write(owner, state, getValue(state, now));
+
+    if (now - state.begin >= state.fade.duration)
+    {
+        return false;
+    }
+
+    state.next = now + state.interval * static_cast<int64_t>(stretch) / 1000;
+    return true;
+}
+
+void FrameScheduler::tick()
+{
+    auto now = clock.now();
+    auto stretch = getStretch();
+
+    // Frames due shortly are written now, sparing a wakeup
+    auto horizon = now + minInterval / 2;
+
+    for (auto it = fades.begin(); it != fades.end();)
+    {
+        auto& [owner, state] = *it;
+        bool done = state.next <= horizon &&
+                    !advance(owner, state, now, stretch);
+        it = done ? fades.erase(it) : std::next(it);
+    }
+
+    schedule();
+}
+
+void FrameScheduler::schedule()
+{
+    if (fades.empty())
+    {
+        timer.setEnabled(false);
+        return;
+    }
+
+    auto next = std::ranges::min_element(fades, {}, [](const auto& entry) {
+                    return entry.second.next;
+                })->second.next;
+
+    auto now = clock.now();
+    timer.restartOnce(next > now ? next - now : Clock::duration::zero());
+}
+
+} // namespace led
+} // namespace phosphor
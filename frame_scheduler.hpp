@@ -0,0 +1,190 @@
+#pragma once
+
+#include "gamma.hpp"
+
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+
+namespace phosphor
+{
+namespace led
+{
+
+/** @class FrameScheduler
+ *  @brief Steps the brightness of fading LEDs
+ *
+ *  A single timer is shared by all fades and disabled while none is
+ *  active. Every tick steps all fades that are due, so concurrent fades
+ *  cost one wakeup. The frame rate of each LED adapts to the number of
+ *  distinct values of its fade and to the time its device takes for a
+ *  write, and all frame rates are scaled down together once the writes
+ *  would exceed the CPU budget of the scheduler.
+ */
+class FrameScheduler
+{
+  public:
+    FrameScheduler() = delete;
+    ~FrameScheduler() = default;
+    FrameScheduler(const FrameScheduler&) = delete;
+    FrameScheduler& operator=(const FrameScheduler&) = delete;
+    FrameScheduler(FrameScheduler&&) = delete;
+    FrameScheduler& operator=(FrameScheduler&&) = delete;
+
+    /** @brief Writes a brightness value to the LED */
+    using Apply = std::function<void(unsigned long)>;
+
+    /** @brief A fade between two levels */
+    struct Fade
+    {
+        /** @brief Brightness values of the LED by level */
+        const BrightnessTable* table;
+
+        /** @brief Level in percent the fade starts at */
+        uint8_t from;
+
+        /** @brief Level in percent the fade ends at */
+        uint8_t to;
+
+        /** @brief Duration of the fade */
+        std::chrono::milliseconds duration;
+
+        /** @brief Callback writing a frame */
+        Apply apply;
+    };
+
+    /** @brief Constructs the scheduler
+     *
+     *  @param[in] event  - event loop to run the timer on
+     *  @param[in] budget - share of one CPU the writes of all fades may
+     *                      take, in per mille
+     */
+    explicit FrameScheduler(const sdeventplus::Event& event,
+                            unsigned budget = defaultBudget);
+
+    /** @brief Starts a fade, replacing the one of the owner
+     *
+     *  The first frame is written right away, the last one once the
+     *  duration has passed.
+     *
+     *  @param[in] owner - identifies the fade, usually the LED
+     *  @param[in] fade  - the fade
+     */
+    void start(const void* owner, Fade fade);
+
+    /** @brief Stops the fade of the owner, if any, at its current frame
+     *
+     *  @param[in] owner - identifies the fade
+     */
+    void stop(const void* owner);
+
+    /** @brief Stops the fade of the owner and drops its write statistics
+     *
+     *  @param[in] owner - identifies the fade
+     */
+    void forget(const void* owner);
+
+    /** @brief Whether a fade of the owner is active
+     *
+     *  @param[in] owner - identifies the fade
+     */
+    bool isActive(const void* owner) const
+    {
+        return fades.contains(owner);
+    }
+
+    /** @brief Default CPU budget, 5% of one CPU */
+    static constexpr unsigned defaultBudget = 50;
+
+    /** @brief Shortest frame interval, 100 frames per second */
+    static constexpr std::chrono::milliseconds minInterval{10};
+
+    /** @brief Longest frame interval, 10 frames per second */
+    static constexpr std::chrono::milliseconds maxInterval{100};
+
+    /** @brief A device may be busy with writes for 1/deviceShare of the
+     *   time of a fade
+     */
+    static constexpr unsigned deviceShare = 20;
+
+  private:
+    using Clock = sdeventplus::Clock<sdeventplus::ClockId::Monotonic>;
+
+    /** @brief Progress of one fade */
+    struct State
+    {
+        Fade fade;
+
+        /** @brief When the fade started */
+        Clock::time_point begin;
+
+        /** @brief When to write the next frame */
+        Clock::time_point next;
+
+        /** @brief Frame interval derived from the fade and the device */
+        std::chrono::microseconds interval;
+
+        /** @brief Value written last */
+        unsigned long value;
+    };
+
+    /** @brief Clock of the event loop */
+    Clock clock;
+
+    /** @brief Timer shared by all fades */
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> timer;
+
+    /** @brief Allowed write time per second of all fades */
+    std::chrono::microseconds budget;
+
+    /** @brief Active fades by owner */
+    std::map<const void*, State> fades;
+
+    /** @brief Average time of a write by owner */
+    std::map<const void*, std::chrono::microseconds> costs;
+
+    /** @brief Steps all due fades and rearms the timer */
+    void tick();
+
+    /** @brief Writes the frame of a fade if its value changed
+     *
+     *  @param[in] owner - identifies the fade
+     *  @param[in] state - the fade
+     *  @param[in] value - brightness value of the frame
+     */
+    void write(const void* owner, State& state, unsigned long value);
+
+    /** @brief Writes the frame of a fade that is due
+     *
+     *  @param[in] owner   - identifies the fade
+     *  @param[in] state   - the fade
+     *  @param[in] now     - current time
+     *  @param[in] stretch - stretch of the frame interval, in per mille
+     *  @return false once the fade has finished
+     */
+    bool advance(const void* owner, State& state, Clock::time_point now,
+                 uint64_t stretch);
+
+    /** @brief Frame interval of a fade on its device */
+    std::chrono::microseconds getInterval(const void* owner,
+                                          const Fade& fade) const;
+
+    /** @brief Stretch of all intervals keeping the writes in budget,
+     *   in per mille
+     */
+    uint64_t getStretch() const;
+
+    /** @brief Brightness value of a fade at a point in time */
+    static unsigned long getValue(const State& state, Clock::time_point now);
+
+    /** @brief Arms the timer for the earliest frame, or disables it */
+    void schedule();
+};
+
+} // namespace led
+} // namespace phosphor
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "gamma.hpp"
+
+#include <map>
+
+namespace phosphor
+{
+namespace led
+{
+
+static constexpr BrightnessTable onOffTable = makeBrightnessTable(1);
+static constexpr BrightnessTable byteTable = makeBrightnessTable(255);
+
+const BrightnessTable& getBrightnessTable(unsigned long max)
+{
+    switch (max)
+    {
+        case 1:
+            return onOffTable;
+        case 255:
+            return byteTable;
+        default:
+            break;
+    }
+
+    static std::map<unsigned long, BrightnessTable> tables;
+
+    auto it = tables.find(max);
+    if (it == tables.end())
+    {
+        it = tables.emplace(max, makeBrightnessTable(max)).first;
+    }
+
+    return it->second;
+}
+
+uint8_t toLevel(const BrightnessTable& table, unsigned long value)
+{
+    // Levels sharing a value map back to the highest of them, so a lit
+    // on/off LED reads as fully on
+    auto it = std::ranges::upper_bound(table, value);
+    if (it == table.begin())
+    {
+        return 0;
+    }
+
+    return static_cast<uint8_t>(std::distance(table.begin(), it) - 1);
+}
+
+} // namespace led
+} // namespace phosphor
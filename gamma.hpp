@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace phosphor
+{
+namespace led
+{
+
+/** @brief Brightness level of a fully lit LED, in percent */
+constexpr uint8_t maxLevel = 100;
+
+/** @brief Fixed point scale of the luminance table */
+constexpr uint64_t luminanceScale = 65535;
+
+/** @brief Relative luminance of a perceived lightness, after CIE 1976
+ *
+ *  @param[in] level - lightness in percent
+ *  @return luminance scaled to luminanceScale
+ */
+constexpr uint64_t luminance(uint8_t level)
+{
+    // Y = L / 903.3 up to L = 8, Y = ((L + 16) / 116)^3 above
+    if (level <= 8)
+    {
+        return (level * luminanceScale * 10 + 4516) / 9033;
+    }
+
+    constexpr uint64_t cube = 116 * 116 * 116;
+    uint64_t lightness = level + 16U;
+    return (lightness * lightness * lightness * luminanceScale + cube / 2) /
+           cube;
+}
+
+/** @brief Luminance of each level, independent of the LED */
+using LuminanceTable = std::array<uint64_t, maxLevel + 1>;
+
+constexpr LuminanceTable makeLuminanceTable()
+{
+    LuminanceTable table{};
+    for (uint8_t level = 0; level <= maxLevel; level++)
+    {
+        table[level] = luminance(level);
+    }
+    return table;
+}
+
+/** @brief Perceptually linear luminance curve, computed at compile time */
+constexpr LuminanceTable luminanceTable = makeLuminanceTable();
+
+static_assert(luminanceTable.front() == 0);
+static_assert(luminanceTable.back() == luminanceScale);
+static_assert(std::ranges::is_sorted(luminanceTable));
+
+/** @brief Brightness value of each level for one max_brightness */
+using BrightnessTable = std::array<unsigned long, maxLevel + 1>;
+
+/** @brief Scales the luminance curve to a max_brightness
+ *
+ *  @param[in] max - max_brightness of the LED
+ *  @return brightness value by level
+ */
+constexpr BrightnessTable makeBrightnessTable(unsigned long max)
+{
+    BrightnessTable table{};
+    for (uint8_t level = 0; level <= maxLevel; level++)
+    {
+        auto value = (max * luminanceTable[level] + luminanceScale / 2) /
+                     luminanceScale;
+
+        // Every level above 0 has to light the LED
+        table[level] = (level > 0 && value == 0) ? std::min(max, 1UL) : value;
+    }
+    return table;
+}
+
+/** @brief Shared brightness table for a max_brightness
+ *
+ *  The tables of the common on/off and 8 bit LEDs are compiled in, others
+ *  are built once per distinct max_brightness.
+ *
+ *  @param[in] max - max_brightness of the LED
+ *  @return brightness value by level
+ */
+const BrightnessTable& getBrightnessTable(unsigned long max);
+
+/** @brief Highest level not brighter than a brightness value
+ *
+ *  @param[in] table - brightness table of the LED
+ *  @param[in] value - brightness value
+ *  @return level in percent
+ */
+uint8_t toLevel(const BrightnessTable& table, unsigned long value);
+
+} // namespace led
+} // namespace phosphor
@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "arbitration_interface.hpp"
+
+#include "fallback_vtable.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/message.hpp>
+#include <xyz/openbmc_project/Common/error.hpp>
+
+#include <string>
+
+namespace phosphor
+{
+namespace led
+{
+namespace sysfs
+{
+namespace interface
+{
+
+namespace
+{
+
+/** @brief Unique name of the caller
+ *
+ *  Requests are withdrawn when their connection goes, a caller without a
+ *  name, e.g. on a connection without a broker, can not make any.
+ */
+std::string getClient(sdbusplus::message_t& message)
+{
+    using sdbusplus::xyz::openbmc_project::Common::Error::NotAllowed;
+
+    const char* sender = message.get_sender();
+    if (sender == nullptr)
+    {
+        throw NotAllowed();
+    }
+
+    return sender;
+}
+
+} // namespace
+
+ArbitrationInterface::ArbitrationInterface(phosphor::led::Physical& led,
+                                           phosphor::led::Arbiter& arbiter) :
+    led(led), arbiter(arbiter)
+{}
+
+sdbusplus::slot_t ArbitrationInterface::serve(sdbusplus::bus_t& bus,
+                                              const char* parent,
+                                              sd_bus_object_find_t find,
+                                              void* context)
+{
+    return addFallbackVtable(bus, parent, arbitrationInterface, vtable.data(),
+                             find, context);
+}
+
+int ArbitrationInterface::requestConfigure(sd_bus_message* msg, void* context,
+                                           sd_bus_error* error)
+{
+    if (msg == nullptr && context == nullptr)
+    {
+        lg2::error("Unable to configure request");
+        return -EINVAL;
+    }
+
+    try
+    {
+        auto message = sdbusplus::message_t(msg);
+        auto [state, priority] = message.unpack<std::string, uint8_t>();
+        auto action = phosphor::led::Physical::convertActionFromString(state);
+
+        // Requests belong to the connection, they go when it goes
+        auto* self = static_cast<ArbitrationInterface*>(context);
+        self->arbiter.request(self->led, getClient(message), priority,
+                              action);
+
+        auto reply = message.new_method_return();
+        reply.method_return();
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        return sd_bus_error_set(error, e.name(), e.description());
+    }
+
+    return 1;
+}
+
+int ArbitrationInterface::releaseConfigure(sd_bus_message* msg, void* context,
+                                           sd_bus_error* error)
+{
+    using sdbusplus::xyz::openbmc_project::Common::Error::ResourceNotFound;
+
+    if (msg == nullptr && context == nullptr)
+    {
+        lg2::error("Unable to configure release");
+        return -EINVAL;
+    }
+
+    try
+    {
+        auto message = sdbusplus::message_t(msg);
+        auto priority = message.unpack<uint8_t>();
+
+        auto* self = static_cast<ArbitrationInterface*>(context);
+        if (!self->arbiter.release(self->led, getClient(message), priority))
+        {
+            throw ResourceNotFound();
+        }
+
+        auto reply = message.new_method_return();
+        reply.method_return();
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        return sd_bus_error_set(error, e.name(), e.description());
+    }
+
+    return 1;
+}
+
+const std::array<sdbusplus::vtable::vtable_t, 4> ArbitrationInterface::vtable =
+    {sdbusplus::vtable::start(),
+     // Request takes a State and a priority, higher wins, and returns void
+     sdbusplus::vtable::method("Request", "sy", "", requestConfigure),
+     // Release withdraws the request at a priority and returns void
+     sdbusplus::vtable::method("Release", "y", "", releaseConfigure),
+     sdbusplus::vtable::end()};
+
+} // namespace interface
+} // namespace sysfs
+} // namespace led
+} // namespace phosphor
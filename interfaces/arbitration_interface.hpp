@@ -0,0 +1,104 @@
+#pragma once
+
+#include "arbiter.hpp"
+#include "physical.hpp"
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/slot.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <array>
+
+static constexpr auto arbitrationInterface =
+    "xyz.openbmc_project.Led.Sysfs.Arbitration";
+
+namespace phosphor
+{
+namespace led
+{
+namespace sysfs
+{
+namespace interface
+{
+
+/** @class ArbitrationInterface
+ *  @brief Lets several clients request a State for the same LED
+ *
+ *  Rather than overwriting each other's State, clients request a State
+ *  at a priority. The highest priority wins, and a request is withdrawn
+ *  by Release or when its client leaves the bus.
+ */
+class ArbitrationInterface
+{
+  public:
+    ArbitrationInterface() = delete;
+    ArbitrationInterface(const ArbitrationInterface&) = delete;
+    ArbitrationInterface& operator=(const ArbitrationInterface&) = delete;
+    ArbitrationInterface(ArbitrationInterface&&) = delete;
+    ArbitrationInterface& operator=(ArbitrationInterface&&) = delete;
+    ~ArbitrationInterface() = default;
+
+    /**
+     *  @brief Construct the interface of an LED, it is served by serve().
+     *
+     *  @param[in] led     - the LED.
+     *  @param[in] arbiter - the arbiter shared by all LEDs.
+     */
+
+    ArbitrationInterface(phosphor::led::Physical& led,
+                         phosphor::led::Arbiter& arbiter);
+
+    /**
+     *  @brief Serves the interface of all LEDs with one registration.
+     *
+     *  @param[in] bus     - D-Bus object.
+     *  @param[in] parent  - path the LEDs are below.
+     *  @param[in] find    - resolves the interface object of an LED.
+     *  @param[in] context - passed to find.
+     *
+     *  @return the registration, the interface is served while it lives.
+     */
+
+    static sdbusplus::slot_t serve(sdbusplus::bus_t& bus, const char* parent,
+                                   sd_bus_object_find_t find, void* context);
+
+  private:
+    /**
+     *  @brief The LED.
+     */
+
+    phosphor::led::Physical& led;
+
+    /**
+     *  @brief The arbiter shared by all LEDs.
+     */
+
+    phosphor::led::Arbiter& arbiter;
+
+    /**
+     *  @brief Systemd bus callback for the Request method.
+     */
+
+    static int requestConfigure(sd_bus_message* msg, void* context,
+                                sd_bus_error* error);
+
+    /**
+     *  @brief Systemd bus callback for the Release method.
+     */
+
+    static int releaseConfigure(sd_bus_message* msg, void* context,
+                                sd_bus_error* error);
+
+    /**
+     *  @brief Systemd vtable structure that contains all the
+     *  methods, signals, and properties of this interface with their
+     *  respective systemd attributes
+     */
+
+    static const std::array<sdbusplus::vtable::vtable_t, 4> vtable;
+};
+
+} // namespace interface
+} // namespace sysfs
+} // namespace led
+} // namespace phosphor
@@ -0,0 +1,167 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "dimming_interface.hpp"
+
+#include "fallback_vtable.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <map>
+#include <string_view>
+#include <variant>
+
+namespace phosphor
+{
+namespace led
+{
+namespace sysfs
+{
+namespace interface
+{
+
+DimmingInterface::DimmingInterface(sdbusplus::bus_t& bus,
+                                   const std::string& path,
+                                   phosphor::led::Physical& led) :
+    bus(bus), path(path), led(led)
+{}
+
+sdbusplus::slot_t DimmingInterface::serve(sdbusplus::bus_t& bus,
+                                          const char* parent,
+                                          sd_bus_object_find_t find,
+                                          void* context)
+{
+    return addFallbackVtable(bus, parent, dimmingInterface, vtable.data(),
+                             find, context);
+}
+
+void DimmingInterface::appendProperties(sdbusplus::message_t& m) const
+{
+    m.append(std::map<std::string, std::variant<uint8_t, uint16_t>>{
+        {"Brightness", led.getLevel()},
+        {"FadeIn", led.getFadeIn()},
+        {"FadeOut", led.getFadeOut()},
+    });
+}
+
+int DimmingInterface::getProperty(
+    sd_bus* /*bus*/, const char* /*path*/, const char* /*interface*/,
+    const char* property, sd_bus_message* reply, void* context,
+    sd_bus_error* error)
+{
+    if (reply == nullptr || context == nullptr)
+    {
+        lg2::error("Unable to get dimming property");
+        return -EINVAL;
+    }
+
+    try
+    {
+        auto* self = static_cast<DimmingInterface*>(context);
+        auto m = sdbusplus::message_t(reply);
+        std::string_view name(property);
+
+        if (name == "Brightness")
+        {
+            m.append(self->led.getLevel());
+        }
+        else if (name == "FadeIn")
+        {
+            m.append(self->led.getFadeIn());
+        }
+        else
+        {
+            m.append(self->led.getFadeOut());
+        }
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        return sd_bus_error_set(error, e.name(), e.description());
+    }
+
+    return 1;
+}
+
+int DimmingInterface::setBrightness(
+    sd_bus* /*bus*/, const char* /*path*/, const char* /*interface*/,
+    const char* /*property*/, sd_bus_message* value, void* context,
+    sd_bus_error* error)
+{
+    if (value == nullptr || context == nullptr)
+    {
+        lg2::error("Unable to set brightness");
+        return -EINVAL;
+    }
+
+    try
+    {
+        auto* self = static_cast<DimmingInterface*>(context);
+        auto m = sdbusplus::message_t(value);
+
+        self->led.setLevel(m.unpack<uint8_t>());
+        sd_bus_emit_properties_changed(self->bus.get(), self->path.c_str(),
+                                       dimmingInterface, "Brightness",
+                                       nullptr);
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        return sd_bus_error_set(error, e.name(), e.description());
+    }
+
+    return 1;
+}
+
+int DimmingInterface::setFade(sd_bus* /*bus*/, const char* /*path*/,
+                              const char* /*interface*/, const char* property,
+                              sd_bus_message* value, void* context,
+                              sd_bus_error* error)
+{
+    if (value == nullptr || context == nullptr)
+    {
+        lg2::error("Unable to set fade");
+        return -EINVAL;
+    }
+
+    try
+    {
+        auto* self = static_cast<DimmingInterface*>(context);
+        auto m = sdbusplus::message_t(value);
+        auto duration = m.unpack<uint16_t>();
+
+        if (std::string_view(property) == "FadeIn")
+        {
+            self->led.setFadeIn(duration);
+        }
+        else
+        {
+            self->led.setFadeOut(duration);
+        }
+        sd_bus_emit_properties_changed(self->bus.get(), self->path.c_str(),
+                                       dimmingInterface, property, nullptr);
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        return sd_bus_error_set(error, e.name(), e.description());
+    }
+
+    return 1;
+}
+
+const std::array<sdbusplus::vtable::vtable_t, 5> DimmingInterface::vtable = {
+    sdbusplus::vtable::start(),
+    // Perceived brightness of the lit LED in percent
+    sdbusplus::vtable::property("Brightness", "y", getProperty, setBrightness,
+                                sdbusplus::vtable::property_::emits_change),
+    // Milliseconds turning the LED on takes, 0 switches instantly
+    sdbusplus::vtable::property("FadeIn", "q", getProperty, setFade,
+                                sdbusplus::vtable::property_::emits_change),
+    // Milliseconds turning the LED off takes, 0 switches instantly
+    sdbusplus::vtable::property("FadeOut", "q", getProperty, setFade,
+                                sdbusplus::vtable::property_::emits_change),
+    sdbusplus::vtable::end()};
+
+} // namespace interface
+} // namespace sysfs
+} // namespace led
+} // namespace phosphor
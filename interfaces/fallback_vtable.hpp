@@ -0,0 +1,54 @@
+#pragma once
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/slot.hpp>
+#include <sdbusplus/vtable.hpp>
+
+namespace phosphor
+{
+namespace led
+{
+namespace sysfs
+{
+namespace interface
+{
+
+/** @brief Serves an interface on all objects below a path with a single
+ *  vtable registration
+ *
+ *  sd-bus calls find on each access to resolve the object of the path,
+ *  its result is the context of the vtable callbacks. Objects added
+ *  later are served without registering them.
+ *
+ *  @param[in] bus       - D-Bus object.
+ *  @param[in] parent    - path the objects are below.
+ *  @param[in] interface - the interface.
+ *  @param[in] vtable    - the vtable of the interface.
+ *  @param[in] find      - resolves the object of a path.
+ *  @param[in] context   - passed to find.
+ *
+ *  @return the registration, the interface is served while it lives.
+ */
+inline sdbusplus::slot_t
+    addFallbackVtable(sdbusplus::bus_t& bus, const char* parent,
+                      const char* interface,
+                      const sdbusplus::vtable::vtable_t* vtable,
+                      sd_bus_object_find_t find, void* context)
+{
+    sd_bus_slot* slot = nullptr;
+    auto rc = sd_bus_add_fallback_vtable(bus.get(), &slot, parent, interface,
+                                         vtable, find, context);
+    if (rc < 0)
+    {
+        throw sdbusplus::exception::SdBusError(-rc,
+                                               "sd_bus_add_fallback_vtable");
+    }
+
+    return sdbusplus::slot_t(slot);
+}
+
+} // namespace interface
+} // namespace sysfs
+} // namespace led
+} // namespace phosphor
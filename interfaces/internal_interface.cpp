@@ -16,11 +16,16 @@
 
 #include "internal_interface.hpp"
 
+#include "peer_interface.hpp"
+
+#include <sdbusplus/exception.hpp>
 #include <sdbusplus/message.hpp>
+#include <xyz/openbmc_project/Common/error.hpp>
 
 #include <algorithm>
-#include <iterator>
-#include <numeric>
+#include <chrono>
+#include <utility>
+#include <variant>
 
 namespace phosphor
 {
@@ -31,72 +36,393 @@ namespace sysfs
 namespace interface
 {
 
-InternalInterface::InternalInterface(sdbusplus::bus_t& bus, const char* path) :
-    bus(bus), serverInterface(bus, path, internalInterface, vtable.data(), this)
-{}
+InternalInterface::InternalInterface(sdbusplus::bus_t& bus, const char* path,
+                                     const sdeventplus::Event& event,
+                                     std::filesystem::path root) :
+    sequencer(event), frames(event), scrubber(event), arbiter(bus),
+    limiter(event, phosphor::led::LedConfig::RateLimit{}.rate,
+            phosphor::led::LedConfig::RateLimit{}.burst),
+    retrier(event), lagMonitor(event), lampTest(event), writeQueue(event),
+    event(event),
+    objManager(bus, path), root(std::move(root)), bus(bus),
+    serverInterface(bus, path, internalInterface, vtable.data(), this),
+    monitor(bus, path, lagMonitor)
+{
+    lampTest.setWriteQueue(&writeQueue);
+
+    // One registration per interface serves the objects of all LEDs
+    ledSlots.reserve(6);
+    for (auto* serve : {TriggerInterface::serve, PatternInterface::serve,
+                        DimmingInterface::serve, ArbitrationInterface::serve,
+                        StatisticsInterface::serve, MultiColorInterface::serve})
+    {
+        ledSlots.emplace_back(serve(bus, physParent, findInterface, this));
+    }
+}
+
+std::string InternalInterface::getDbusName(const LedNameParts& parts)
+{
+    std::string name;
+    name.reserve(parts.devicename.size() + parts.function.size() +
+                 parts.color.size() + 2);
+
+    for (auto part : {parts.devicename, parts.function, parts.color})
+    {
+        if (part.empty())
+        {
+            continue;
+        }
+
+        if (!name.empty())
+        {
+            name += '_';
+        }
+
+        // Object path elements may only hold [A-Za-z0-9_]
+        for (auto c : part)
+        {
+            bool valid = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
+                         (c >= '0' && c <= '9') || c == '_';
+            name += valid ? c : '_';
+        }
+    }
+
+    return name;
+}
 
 std::string InternalInterface::getDbusName(const LedDescr& ledDescr)
 {
-    std::vector<std::string> words;
-    if (ledDescr.devicename.has_value())
+    return getDbusName(LedNameParts{ledDescr.devicename.value_or(""),
+                                    ledDescr.color.value_or(""),
+                                    ledDescr.function.value_or("")});
+}
+
+void InternalInterface::appendNoProperties(sdbusplus::message_t& m)
+{
+    m.append(std::map<std::string, std::variant<std::string>>{});
+}
+
+std::map<std::string, PhysicalProperties>
+    InternalInterface::getProperties(const PhysicalServer& led)
+{
+    return {
+        {"State", led.state()},
+        {"DutyOn", led.dutyOn()},
+        {"Color", led.color()},
+        {"Period", led.period()},
+    };
+}
+
+LedObject::LedObject(sdbusplus::bus_t& bus, std::string_view name,
+                     std::unique_ptr<phosphor::led::SysfsLed> led,
+                     const std::string& color,
+                     phosphor::led::Arbiter& arbiter) :
+    name(name), path(std::string(physParent) + "/" + this->name),
+    physical(bus, path, std::move(led), color, true),
+    trigger(bus, path, physical), pattern(physical),
+    dimming(bus, path, physical), arbitration(physical, arbiter),
+    statistics(physical)
+{
+    if (physical.getMultiColor() != nullptr)
     {
-        words.emplace_back(ledDescr.devicename.value());
+        multicolor.emplace(bus, path, physical);
     }
-    if (ledDescr.function.has_value())
+}
+
+LedObject::LedObject(sdbusplus::bus_t& bus,
+                     const phosphor::led::LedConfig::Entry& entry,
+                     phosphor::led::Arbiter& arbiter) :
+    name(entry.name), path(std::string(physParent) + "/" + name),
+    physical(bus, path, entry.color, entry.state, true),
+    trigger(bus, path, physical), pattern(physical),
+    dimming(bus, path, physical), arbitration(physical, arbiter),
+    statistics(physical)
+{}
+
+phosphor::led::Physical*
+    InternalInterface::createLEDPath(const std::string& ledName,
+                                     bool deferSignals)
+{
+    auto path = root / ledName;
+
+    if (!std::filesystem::exists(path))
     {
-        words.emplace_back(ledDescr.function.value());
+        lg2::error("No such directory {PATH}", "PATH", path.string());
+        return nullptr;
     }
 
-    if (ledDescr.color.has_value())
+    auto sled = std::make_unique<phosphor::led::SysfsLed>(std::move(path));
+
+    // Configured LEDs have their object already, under any of their names,
+    // and were announced when it was created
+    const auto* entry = config.find(ledName);
+    if (entry != nullptr)
     {
-        words.emplace_back(ledDescr.color.value());
+        bindLED(*entry, std::move(sled));
+        return nullptr;
     }
 
-    std::string s =
-        std::accumulate(std::next(words.begin()), words.end(), words[0],
-                        [](std::string a, const std::string& b) {
-                            return std::move(a) + "_" + b;
-                        });
+    // Convert LED name in sysfs into DBus name
+    const auto parts = parseLedName(ledName);
+    auto name = getDbusName(parts);
+    if (name.empty())
+    {
+        lg2::error("LED {NAME} has no name usable on DBus", "NAME", ledName);
+        return nullptr;
+    }
 
-    // we assume the string to be a correct dbus name besides
-    // this detail
-    std::replace(s.begin(), s.end(), '-', '_');
+    lg2::debug("LED {NAME} receives dbus name {DBUSNAME}", "NAME", ledName,
+               "DBUSNAME", name);
 
-    return s;
+    return addLED(name, std::move(sled), std::string(parts.color),
+                  deferSignals);
 }
 
-void InternalInterface::createLEDPath(const std::string& ledName)
+auto InternalInterface::findLED(const std::string& name)
+    -> std::vector<std::unique_ptr<LedObject>>::iterator
 {
-    std::string name;
-    std::string path = devParent + ledName;
+    return std::ranges::lower_bound(
+        leds, name, {},
+        [](const auto& object) -> const std::string& { return object->name; });
+}
 
-    if (!std::filesystem::exists(fs::path(path)))
+phosphor::led::Physical* InternalInterface::addLED(
+    const std::string& name, std::unique_ptr<phosphor::led::SysfsLed> sled,
+    const std::string& color, bool deferSignals)
+{
+    // The group owns the path, the LED would hide behind it
+    if (groups.contains(name))
     {
-        lg2::error("No such directory {PATH}", "PATH", path);
-        return;
+        lg2::error("LED {NAME} is named like a group", "NAME", name);
+        return nullptr;
     }
 
-    auto sled = std::make_unique<phosphor::led::SysfsLed>(fs::path(path));
+    auto it = findLED(name);
+    if (it != leds.end() && (*it)->name == name)
+    {
+        return nullptr;
+    }
 
-    // Convert LED name in sysfs into DBus name
-    const LedDescr ledDescr = sled->getLedDescr();
+    // All interfaces have to be in place before InterfacesAdded is sent
+    auto& object = **leds.insert(
+        it, std::make_unique<LedObject>(bus, name, std::move(sled), color,
+                                        arbiter));
+    attachLED(object, deferSignals);
 
-    name = getDbusName(ledDescr);
+    return &object.physical;
+}
 
-    lg2::debug("LED {NAME} receives dbus name {DBUSNAME}", "NAME", ledName,
-               "DBUSNAME", name);
+void InternalInterface::preregisterLEDs(phosphor::led::LedConfig ledConfig)
+{
+    config = std::move(ledConfig);
 
-    // Unique path name representing a single LED.
-    std::string objPath = std::string(physParent) + "/" + name;
+    const auto& limit = config.getRateLimit();
+    limiter.setLimit(limit.rate, limit.burst);
 
-    if (leds.contains(objPath))
+    for (const auto& entry : config.getEntries())
+    {
+        auto it = findLED(entry.name);
+        if (it != leds.end() && (*it)->name == entry.name)
+        {
+            continue;
+        }
+
+        // Nobody can address us yet, so there is nobody to signal
+        auto& object = **leds.insert(
+            it, std::make_unique<LedObject>(bus, entry, arbiter));
+        attachLED(object, true);
+    }
+
+    for (const auto& group : config.getGroups())
+    {
+        auto it = findLED(group.name);
+        if (it != leds.end() && (*it)->name == group.name)
+        {
+            lg2::error("Group {NAME} is named like an LED", "NAME", group.name);
+            continue;
+        }
+
+        // The configuration only names configured LEDs as members
+        std::vector<phosphor::led::Physical*> members;
+        members.reserve(group.members.size());
+        for (const auto& name : group.members)
+        {
+            members.emplace_back(&(*findLED(name))->physical);
+        }
+
+        auto path = std::string(physParent) + "/" + group.name;
+        auto& slot = groups[group.name];
+        slot = std::make_unique<phosphor::led::Logical>(bus, path, members,
+                                                        true);
+        auto& logical = *slot;
+        logical.setWriteQueue(&writeQueue);
+
+        objManager.add(path, {{physicalInterface,
+                               [&logical](sdbusplus::message_t& m) {
+                                   m.append(getProperties(logical));
+                               }}});
+        for (auto* member : members)
+        {
+            member->onChange([this, path]() { objManager.invalidate(path); });
+        }
+    }
+}
+
+int InternalInterface::findInterface(sd_bus* /*bus*/, const char* path,
+                                     const char* interface, void* context,
+                                     void** found, sd_bus_error* /*error*/)
+{
+    auto* self = static_cast<InternalInterface*>(context);
+
+    // Groups only have Physical, which they register themselves
+    auto name = PeerInterface::objectName(path);
+    if (!name)
+    {
+        return 0;
+    }
+
+    auto leaf = std::string(*name);
+    auto it = self->findLED(leaf);
+    if (it == self->leds.end() || (*it)->name != leaf)
+    {
+        return 0;
+    }
+
+    auto& object = **it;
+    std::string_view requested(interface);
+    if (requested == triggerInterface)
+    {
+        *found = &object.trigger;
+    }
+    else if (requested == patternInterface)
+    {
+        *found = &object.pattern;
+    }
+    else if (requested == dimmingInterface)
+    {
+        *found = &object.dimming;
+    }
+    else if (requested == arbitrationInterface)
+    {
+        *found = &object.arbitration;
+    }
+    else if (requested == statisticsInterface)
+    {
+        *found = &object.statistics;
+    }
+    else if (requested == multiColorInterface && object.multicolor)
+    {
+        *found = &*object.multicolor;
+    }
+    else
+    {
+        return 0;
+    }
+
+    return 1;
+}
+
+void InternalInterface::attachLED(LedObject& object, bool deferSignals)
+{
+    auto& led = object.physical;
+    led.setArbiter(&arbiter);
+    led.setSequencer(&sequencer);
+    led.setFrameScheduler(&frames);
+    led.setRateLimiter(&limiter);
+    led.setRetryScheduler(&retrier);
+    led.setLagMonitor(&lagMonitor);
+    led.setWriteQueue(&writeQueue);
+    lagMonitor.add(&led, object.name);
+    limiter.add(&led, led.getDevice());
+    led.watchHardware(event);
+    scrubber.add(&led, [&led]() { return led.scrub(); });
+
+    objManager.add(object.getPath(), getInterfaces(object));
+    led.onChange(
+        [this, &object]() { objManager.invalidate(object.getPath()); });
+
+    if (!deferSignals)
+    {
+        led.emit_object_added();
+    }
+}
+
+void InternalInterface::bindLED(const phosphor::led::LedConfig::Entry& entry,
+                                std::unique_ptr<phosphor::led::SysfsLed> sled)
+{
+    auto it = findLED(entry.name);
+    if (it == leds.end() || (*it)->name != entry.name ||
+        (*it)->physical.isBound())
     {
         return;
     }
 
-    leds.emplace(objPath, std::make_unique<phosphor::led::Physical>(
-                              bus, objPath, std::move(sled),
-                              ledDescr.color.value_or("")));
+    lg2::debug("Binding LED {DBUSNAME}", "DBUSNAME", entry.name);
+
+    auto& object = **it;
+    auto& led = object.physical;
+    led.bind(std::move(sled));
+    limiter.add(&led, led.getDevice());
+    led.watchHardware(event);
+
+    // The channels are only known now
+    if (led.getMultiColor() != nullptr && !object.multicolor)
+    {
+        const auto& path = object.getPath();
+        object.multicolor.emplace(bus, path, led);
+        objManager.add(path, getInterfaces(object));
+        bus.emit_interfaces_added(path.c_str(), {multiColorInterface});
+    }
+}
+
+std::vector<ObjectManager::Interface>
+    InternalInterface::getInterfaces(LedObject& object)
+{
+    std::vector<ObjectManager::Interface> interfaces;
+    interfaces.reserve(7);
+    interfaces.emplace_back(physicalInterface,
+                            [&object](sdbusplus::message_t& m) {
+                                m.append(getProperties(object.physical));
+                            });
+    interfaces.emplace_back(triggerInterface,
+                            [&object](sdbusplus::message_t& m) {
+                                object.trigger.appendProperties(m);
+                            });
+    interfaces.emplace_back(patternInterface, appendNoProperties);
+    interfaces.emplace_back(dimmingInterface,
+                            [&object](sdbusplus::message_t& m) {
+                                object.dimming.appendProperties(m);
+                            });
+    interfaces.emplace_back(arbitrationInterface, appendNoProperties);
+    interfaces.emplace_back(statisticsInterface,
+                            [&object](sdbusplus::message_t& m) {
+                                object.statistics.appendProperties(m);
+                            });
+    if (object.multicolor)
+    {
+        interfaces.emplace_back(multiColorInterface,
+                                [&object](sdbusplus::message_t& m) {
+                                    object.multicolor->appendProperties(m);
+                                });
+    }
+
+    return interfaces;
+}
+
+void InternalInterface::emitObjectsAdded(
+    const std::vector<phosphor::led::Physical*>& pending)
+{
+    size_t batched = 0;
+    for (auto* led : pending)
+    {
+        led->emit_object_added();
+
+        if (++batched == signalBatchSize)
+        {
+            bus.flush();
+            batched = 0;
+        }
+    }
 }
 
 void InternalInterface::addLED(const std::string& name)
@@ -104,6 +430,134 @@ void InternalInterface::addLED(const std::string& name)
     createLEDPath(name);
 }
 
+void InternalInterface::addLEDs(const std::vector<std::string>& names)
+{
+    std::vector<phosphor::led::Physical*> pending;
+    pending.reserve(names.size());
+
+    for (const auto& name : names)
+    {
+        auto* led = createLEDPath(name, true);
+        if (led != nullptr)
+        {
+            pending.emplace_back(led);
+        }
+    }
+
+    emitObjectsAdded(pending);
+
+    auto signal = serverInterface.new_signal("EnumerationComplete");
+    signal.append(static_cast<uint32_t>(pending.size()));
+    signal.signal_send();
+}
+
+void InternalInterface::scanLEDs()
+{
+    // The error code overloads, advancing can fail as well as opening
+    std::error_code ec;
+    for (fs::directory_iterator it(root, ec), end; !ec && it != end;
+         it.increment(ec))
+    {
+        // Nobody can address us yet, so there is nobody to signal
+        createLEDPath(it->path().filename().string(), true);
+    }
+
+    if (ec)
+    {
+        lg2::error("Unable to scan {PATH}: {ERROR}", "PATH", root.string(),
+                   "ERROR", ec.message());
+    }
+}
+
+void InternalInterface::setStates(
+    const std::map<std::string, PhysicalServer::Action>& states)
+{
+    using sdbusplus::xyz::openbmc_project::Common::Error::ResourceNotFound;
+
+    std::vector<std::pair<PhysicalServer*, PhysicalServer::Action>> targets;
+    targets.reserve(states.size());
+
+    // Nothing is set unless every path is known
+    std::string_view prefix(physParent);
+    for (const auto& [path, action] : states)
+    {
+        std::string_view view(path);
+        if (!view.starts_with(prefix) || view.size() <= prefix.size() + 1 ||
+            view[prefix.size()] != '/')
+        {
+            throw ResourceNotFound();
+        }
+
+        auto* object = findObject(view.substr(prefix.size() + 1));
+        if (object == nullptr)
+        {
+            throw ResourceNotFound();
+        }
+        targets.emplace_back(object, action);
+    }
+
+    phosphor::led::WriteQueue::Batch batch(&writeQueue);
+    for (const auto& [led, action] : targets)
+    {
+        led->state(action);
+    }
+}
+
+PhysicalServer* InternalInterface::findObject(std::string_view name)
+{
+    if (auto group = groups.find(name); group != groups.end())
+    {
+        return group->second.get();
+    }
+
+    auto leaf = std::string(name);
+    auto it = findLED(leaf);
+    if (it == leds.end() || (*it)->name != leaf)
+    {
+        return nullptr;
+    }
+
+    return &(*it)->physical;
+}
+
+sdbusplus::slot_t InternalInterface::servePeer(sdbusplus::bus_t& bus)
+{
+    sd_bus_slot* slot = nullptr;
+    auto rc = sd_bus_add_object_vtable(bus.get(), &slot, ledPath,
+                                       internalInterface, vtable.data(), this);
+    if (rc < 0)
+    {
+        throw sdbusplus::exception::SdBusError(-rc,
+                                               "sd_bus_add_object_vtable");
+    }
+
+    return sdbusplus::slot_t(slot);
+}
+
+uint64_t InternalInterface::startLampTest(uint32_t duration)
+{
+    using sdbusplus::xyz::openbmc_project::Common::Error::InvalidArgument;
+
+    if (duration == 0)
+    {
+        throw InvalidArgument();
+    }
+
+    std::vector<phosphor::led::Physical*> physicals;
+    physicals.reserve(leds.size());
+    for (auto& object : leds)
+    {
+        physicals.emplace_back(&object->physical);
+    }
+
+    return lampTest.start(physicals, std::chrono::seconds(duration)).count();
+}
+
+bool InternalInterface::cancelLampTest()
+{
+    return lampTest.stop();
+}
+
 // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
 void InternalInterface::removeLED(const std::string& name)
 {
@@ -166,12 +620,146 @@ int InternalInterface::removeLedConfigure(sd_bus_message* msg, void* context,
     return 1;
 }
 
-const std::array<sdbusplus::vtable::vtable_t, 4> InternalInterface::vtable = {
+int InternalInterface::addLedsConfigure(sd_bus_message* msg, void* context,
+                                        sd_bus_error* error)
+{
+    if (msg == nullptr && context == nullptr)
+    {
+        lg2::error("Unable to configure addLeds");
+        return -EINVAL;
+    }
+
+    try
+    {
+        auto message = sdbusplus::message_t(msg);
+        auto ledNames = message.unpack<std::vector<std::string>>();
+
+        auto* self = static_cast<InternalInterface*>(context);
+        self->addLEDs(ledNames);
+
+        auto reply = message.new_method_return();
+        reply.method_return();
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        return sd_bus_error_set(error, e.name(), e.description());
+    }
+
+    return 1;
+}
+
+int InternalInterface::setStatesConfigure(sd_bus_message* msg, void* context,
+                                          sd_bus_error* error)
+{
+    if (msg == nullptr && context == nullptr)
+    {
+        lg2::error("Unable to configure setStates");
+        return -EINVAL;
+    }
+
+    try
+    {
+        auto message = sdbusplus::message_t(msg);
+        auto paths = message.unpack<
+            std::map<sdbusplus::message::object_path, std::string>>();
+
+        std::map<std::string, PhysicalServer::Action> states;
+        for (const auto& [path, state] : paths)
+        {
+            states.emplace(path.str,
+                           PhysicalServer::convertActionFromString(state));
+        }
+
+        auto* self = static_cast<InternalInterface*>(context);
+        self->setStates(states);
+
+        auto reply = message.new_method_return();
+        reply.method_return();
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        return sd_bus_error_set(error, e.name(), e.description());
+    }
+
+    return 1;
+}
+
+int InternalInterface::lampTestConfigure(sd_bus_message* msg, void* context,
+                                         sd_bus_error* error)
+{
+    if (msg == nullptr && context == nullptr)
+    {
+        lg2::error("Unable to configure lampTest");
+        return -EINVAL;
+    }
+
+    try
+    {
+        auto message = sdbusplus::message_t(msg);
+        auto duration = message.unpack<uint32_t>();
+
+        auto* self = static_cast<InternalInterface*>(context);
+        auto elapsed = self->startLampTest(duration);
+
+        auto reply = message.new_method_return();
+        reply.append(elapsed);
+        reply.method_return();
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        return sd_bus_error_set(error, e.name(), e.description());
+    }
+
+    return 1;
+}
+
+int InternalInterface::cancelLampTestConfigure(sd_bus_message* msg,
+                                               void* context,
+                                               sd_bus_error* error)
+{
+    if (msg == nullptr && context == nullptr)
+    {
+        lg2::error("Unable to configure cancelLampTest");
+        return -EINVAL;
+    }
+
+    try
+    {
+        auto message = sdbusplus::message_t(msg);
+
+        auto* self = static_cast<InternalInterface*>(context);
+        auto cancelled = self->cancelLampTest();
+
+        auto reply = message.new_method_return();
+        reply.append(cancelled);
+        reply.method_return();
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        return sd_bus_error_set(error, e.name(), e.description());
+    }
+
+    return 1;
+}
+
+const std::array<sdbusplus::vtable::vtable_t, 9> InternalInterface::vtable = {
     sdbusplus::vtable::start(),
     // AddLed method takes a string parameter and returns void
     sdbusplus::vtable::method("AddLED", "s", "", addLedConfigure),
     // RemoveLed method takes a string parameter and returns void
     sdbusplus::vtable::method("RemoveLED", "s", "", removeLedConfigure),
+    // AddLEDs method takes a string array parameter and returns void
+    sdbusplus::vtable::method("AddLEDs", "as", "", addLedsConfigure),
+    // SetStates takes a State by object path and returns void
+    sdbusplus::vtable::method("SetStates", "a{os}", "", setStatesConfigure),
+    // LampTest takes the seconds the LEDs stay on and returns the
+    // microseconds it took to turn them on
+    sdbusplus::vtable::method("LampTest", "u", "t", lampTestConfigure),
+    // CancelLampTest returns false if no lamp test was running
+    sdbusplus::vtable::method("CancelLampTest", "", "b",
+                              cancelLampTestConfigure),
+    // EnumerationComplete carries the number of LEDs added by AddLEDs
+    sdbusplus::vtable::signal("EnumerationComplete", "u"),
     sdbusplus::vtable::end()};
 
 } // namespace interface
@@ -1,13 +1,36 @@
 #pragma once
 
+#include "arbitration_interface.hpp"
+#include "dimming_interface.hpp"
+#include "lag_monitor.hpp"
+#include "lamp_test.hpp"
+#include "led_config.hpp"
+#include "logical.hpp"
+#include "monitor_interface.hpp"
+#include "multicolor_interface.hpp"
+#include "object_manager.hpp"
+#include "pattern_interface.hpp"
 #include "physical.hpp"
+#include "rate_limiter.hpp"
+#include "retry_scheduler.hpp"
+#include "scrubber.hpp"
+#include "sequencer.hpp"
+#include "statistics_interface.hpp"
+#include "trigger_interface.hpp"
 
 #include <phosphor-logging/lg2.hpp>
 #include <sdbusplus/bus.hpp>
 #include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/slot.hpp>
 #include <sdbusplus/vtable.hpp>
+#include <sdeventplus/event.hpp>
 
-#include <unordered_map>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
 
 static constexpr auto busName = "xyz.openbmc_project.LED.Controller";
 static constexpr auto ledPath = "/xyz/openbmc_project/led";
@@ -15,6 +38,9 @@ static constexpr auto physParent = "/xyz/openbmc_project/led/physical";
 static constexpr auto internalInterface =
     "xyz.openbmc_project.Led.Sysfs.Internal";
 static constexpr auto ledAddMethod = "AddLED";
+static constexpr auto ledAddBulkMethod = "AddLEDs";
+static constexpr auto lampTestMethod = "LampTest";
+static constexpr auto cancelLampTestMethod = "CancelLampTest";
 
 namespace phosphor
 {
@@ -25,6 +51,69 @@ namespace sysfs
 namespace interface
 {
 
+using PhysicalServer = sdbusplus::xyz::openbmc_project::Led::server::Physical;
+using PhysicalProperties = PhysicalServer::PropertiesVariant;
+static constexpr auto physicalInterface = PhysicalServer::interface;
+
+/** @brief D-Bus interfaces hosted on the object of one LED
+ *
+ *  All interfaces of an LED share a single allocation. Only Physical
+ *  registers a vtable per LED, the other interfaces are served for all
+ *  LEDs by one fallback vtable each and resolved by the path of a call.
+ */
+struct LedObject
+{
+    LedObject() = delete;
+    ~LedObject() = default;
+    LedObject(const LedObject&) = delete;
+    LedObject& operator=(const LedObject&) = delete;
+    LedObject(LedObject&&) = delete;
+    LedObject& operator=(LedObject&&) = delete;
+
+    /**
+     *  @brief Creates the interfaces, holding back InterfacesAdded.
+     *
+     *  @param[in] bus     - D-Bus object.
+     *  @param[in] name    - leaf of the object path.
+     *  @param[in] led     - the sysfs LED.
+     *  @param[in] color   - led color name.
+     *  @param[in] arbiter - the arbiter shared by all LEDs.
+     */
+
+    LedObject(sdbusplus::bus_t& bus, std::string_view name,
+              std::unique_ptr<phosphor::led::SysfsLed> led,
+              const std::string& color, phosphor::led::Arbiter& arbiter);
+
+    /**
+     *  @brief Creates the interfaces of a configured LED whose sysfs
+     *  device does not exist yet, holding back InterfacesAdded.
+     *
+     *  @param[in] bus     - D-Bus object.
+     *  @param[in] entry   - the configured LED.
+     *  @param[in] arbiter - the arbiter shared by all LEDs.
+     */
+
+    LedObject(sdbusplus::bus_t& bus,
+              const phosphor::led::LedConfig::Entry& entry,
+              phosphor::led::Arbiter& arbiter);
+
+    /** @brief Full object path of the LED */
+    const std::string& getPath() const
+    {
+        return path;
+    }
+
+    std::string name;
+    std::string path;
+    phosphor::led::Physical physical;
+    TriggerInterface trigger;
+    PatternInterface pattern;
+    DimmingInterface dimming;
+    ArbitrationInterface arbitration;
+    StatisticsInterface statistics;
+    std::optional<MultiColorInterface> multicolor;
+};
+
 class InternalInterface
 {
   public:
@@ -38,11 +127,17 @@ class InternalInterface
     /**
      *  @brief Construct a class to put object onto bus at a dbus path.
      *
-     *  @param[in] bus  - D-Bus object.
-     *  @param[in] path - D-Bus Path.
+     *  Also hosts the ObjectManager for the LEDs below the path.
+     *
+     *  @param[in] bus   - D-Bus object.
+     *  @param[in] path  - D-Bus Path.
+     *  @param[in] event - event loop for the timers shared by the LEDs.
+     *  @param[in] root  - directory of the LED class devices.
      */
 
-    InternalInterface(sdbusplus::bus_t& bus, const char* path);
+    InternalInterface(sdbusplus::bus_t& bus, const char* path,
+                      const sdeventplus::Event& event,
+                      std::filesystem::path root = devParent);
 
     /**
      *  @brief Implementation for the AddLed method to add
@@ -53,6 +148,110 @@ class InternalInterface
 
     void addLED(const std::string& name);
 
+    /**
+     *  @brief Adds an LED under a DBus name.
+     *
+     *  @param[in] name         - DBus name of the LED.
+     *  @param[in] led          - the sysfs LED.
+     *  @param[in] color        - led color name.
+     *  @param[in] deferSignals - hold off the InterfacesAdded signal
+     *
+     *  @return the newly created LED, nullptr if an LED or group has the name.
+     */
+
+    phosphor::led::Physical*
+        addLED(const std::string& name,
+               std::unique_ptr<phosphor::led::SysfsLed> led,
+               const std::string& color, bool deferSignals = false);
+
+    /**
+     *  @brief Implementation for the AddLEDs method to add
+     *  several LEDs at once. Each LED still sends its own
+     *  InterfacesAdded, only the sending is deferred until all
+     *  objects are created and the flushes are done in chunks. A
+     *  single EnumerationComplete signal follows.
+     *
+     *  @param[in] names - LED names to add.
+     */
+
+    void addLEDs(const std::vector<std::string>& names);
+
+    /**
+     *  @brief Creates objects for all LEDs currently present in sysfs.
+     *  Must be called before the bus name is requested, the objects
+     *  are then discovered through GetManagedObjects and no
+     *  InterfacesAdded signals are sent for them.
+     */
+
+    void scanLEDs();
+
+    /**
+     *  @brief Creates objects for the configured LEDs ahead of their
+     *  sysfs devices. An LED appearing under its sysfs name or one of
+     *  its aliases is then bound to its object. Configured groups get
+     *  an object setting all of their members. Must be called before
+     *  scanLEDs().
+     *
+     *  @param[in] config - the configured LEDs.
+     */
+
+    void preregisterLEDs(phosphor::led::LedConfig config);
+
+    /**
+     *  @brief Implementation for the SetStates method to set the State
+     *  of several LEDs and groups in one call. All paths and States are
+     *  checked before any LED is set.
+     *
+     *  @param[in] states - State by object path of the LED or group.
+     *
+     *  @throws ResourceNotFound if a path is not an LED or group.
+     */
+
+    void setStates(const std::map<std::string, PhysicalServer::Action>& states);
+
+    /**
+     *  @brief Finds the LED or group of a name.
+     *
+     *  @param[in] name - leaf of the object path.
+     *
+     *  @return the LED or group, nullptr if there is none.
+     */
+
+    PhysicalServer* findObject(std::string_view name);
+
+    /**
+     *  @brief Serves this interface on a peer to peer connection.
+     *
+     *  @param[in] bus - the peer connection.
+     *
+     *  @return the registration, the interface is served while it lives.
+     */
+
+    sdbusplus::slot_t servePeer(sdbusplus::bus_t& bus);
+
+    /**
+     *  @brief Implementation for the LampTest method to turn all LEDs
+     *  on for a while. The LEDs are restored when the time is up or
+     *  the test is cancelled.
+     *
+     *  @param[in] duration - seconds the LEDs stay on.
+     *
+     *  @return microseconds it took to turn the LEDs on.
+     *
+     *  @throws InvalidArgument if the duration is 0.
+     */
+
+    uint64_t startLampTest(uint32_t duration);
+
+    /**
+     *  @brief Implementation for the CancelLampTest method to end the
+     *  lamp test early and restore the LEDs.
+     *
+     *  @return false if no lamp test was running.
+     */
+
+    bool cancelLampTest();
+
     /**
      *  @brief Implementation for the RemoveLed method to remove
      *  the LED name to dbus path.
@@ -62,6 +261,18 @@ class InternalInterface
 
     void removeLED(const std::string& name);
 
+    /**
+     *  @brief Runs the event loop, the duration of each dispatch is
+     *  monitored.
+     *
+     *  @return the exit code of the loop, or -errno if it failed.
+     */
+
+    int loop()
+    {
+        return lagMonitor.loop();
+    }
+
     /** @brief Generates LED DBus name from LED description
      *
      *  @param[in] name      - LED description
@@ -70,13 +281,134 @@ class InternalInterface
 
     static std::string getDbusName(const LedDescr& ledDescr);
 
+    /** @brief Generates LED DBus name from the parts of the LED name
+     *
+     *  The name is built in a single pass. Characters not allowed in an
+     *  object path element are replaced by '_'.
+     *
+     *  @param[in] parts     - parts of the LED name
+     *  @return              - DBus LED name, empty if all parts are
+     */
+
+    static std::string getDbusName(const LedNameParts& parts);
+
+    /** @brief Collects the xyz.openbmc_project.Led.Physical properties
+     *
+     *  @param[in] led       - the LED
+     *  @return              - properties by name
+     */
+
+    static std::map<std::string, PhysicalProperties>
+        getProperties(const PhysicalServer& led);
+
+    /** @brief Appends the empty a{sv} of an interface without properties
+     *
+     *  @param[in] m         - message to append to
+     */
+
+    static void appendNoProperties(sdbusplus::message_t& m);
+
   private:
     /**
-     *  @brief  Unordered map to declare the sysfs LEDs
+     *  @brief Sequencer playing patterns for all LEDs.
+     */
+
+    phosphor::led::Sequencer sequencer;
+
+    /**
+     *  @brief Frame scheduler stepping fades for all LEDs.
+     */
+
+    phosphor::led::FrameScheduler frames;
+
+    /**
+     *  @brief Scrubber verifying the LEDs against their State.
+     */
+
+    phosphor::led::Scrubber scrubber;
+
+    /**
+     *  @brief Arbiter deciding between the requests of clients.
+     */
+
+    phosphor::led::Arbiter arbiter;
+
+    /**
+     *  @brief Rate limit of the State writes per backing device.
      */
 
-    std::unordered_map<std::string, std::unique_ptr<phosphor::led::Physical>>
-        leds;
+    phosphor::led::RateLimiter limiter;
+
+    /**
+     *  @brief Scheduler retrying failed State writes.
+     */
+
+    phosphor::led::RetryScheduler retrier;
+
+    /**
+     *  @brief Monitor of the dispatch lag and the duration of writes.
+     */
+
+    phosphor::led::LagMonitor lagMonitor;
+
+    /**
+     *  @brief Lamp test turning all LEDs on and restoring them.
+     */
+
+    phosphor::led::LampTest lampTest;
+
+    /**
+     *  @brief Queue submitting the writes of many LEDs at once.
+     */
+
+    phosphor::led::WriteQueue writeQueue;
+
+    /**
+     *  @brief Event loop watching the LEDs.
+     */
+
+    sdeventplus::Event event;
+
+    /**
+     *  @brief ObjectManager with the cached GetManagedObjects reply,
+     *  it has to outlive the LEDs.
+     */
+
+    ObjectManager objManager;
+
+    /**
+     *  @brief The sysfs LEDs, sorted by name
+     */
+
+    std::vector<std::unique_ptr<LedObject>> leds;
+
+    /**
+     *  @brief Fallback vtables serving the interfaces of all LEDs, they
+     *  go before the LEDs they resolve
+     */
+
+    std::vector<sdbusplus::slot_t> ledSlots;
+
+    /**
+     *  @brief Configured groups of LEDs by name, they have to go before
+     *  the LEDs
+     */
+
+    std::map<std::string, std::unique_ptr<phosphor::led::Logical>,
+             std::less<>>
+        groups;
+
+    /**
+     *  @brief LEDs registered ahead of their sysfs devices.
+     */
+
+    phosphor::led::LedConfig config;
+
+    /**
+     *  @brief Directory of the LED class devices.
+     */
+
+    std::filesystem::path root;
 
     /**
      *  @brief sdbusplus D-Bus connection.
@@ -98,13 +430,41 @@ class InternalInterface
     static int removeLedConfigure(sd_bus_message* msg, void* context,
                                   sd_bus_error* error);
 
+    /**
+     *  @brief Systemd bus callback for the AddLEDs method.
+     */
+
+    static int addLedsConfigure(sd_bus_message* msg, void* context,
+                                sd_bus_error* error);
+
+    /**
+     *  @brief Systemd bus callback for the SetStates method.
+     */
+
+    static int setStatesConfigure(sd_bus_message* msg, void* context,
+                                  sd_bus_error* error);
+
+    /**
+     *  @brief Systemd bus callback for the LampTest method.
+     */
+
+    static int lampTestConfigure(sd_bus_message* msg, void* context,
+                                 sd_bus_error* error);
+
+    /**
+     *  @brief Systemd bus callback for the CancelLampTest method.
+     */
+
+    static int cancelLampTestConfigure(sd_bus_message* msg, void* context,
+                                       sd_bus_error* error);
+
     /**
      *  @brief Systemd vtable structure that contains all the
      *  methods, signals, and properties of this interface with their
      *  respective systemd attributes
      */
 
-    static const std::array<sdbusplus::vtable::vtable_t, 4> vtable;
+    static const std::array<sdbusplus::vtable::vtable_t, 9> vtable;
 
     /**
      *  @brief Support for the dbus based instance of this interface.
@@ -112,13 +472,96 @@ class InternalInterface
 
     sdbusplus::server::interface_t serverInterface;
 
+    /**
+     *  @brief Exposes the lag monitor next to this interface.
+     */
+
+    MonitorInterface monitor;
+
     /**
      *   @brief Implementation to create a dbus path for LED.
      *
-     *   @param[in] name - LED name.
+     *   @param[in] name         - LED name.
+     *   @param[in] deferSignals - hold off the InterfacesAdded signal
+     *
+     *   @return the newly created LED, nullptr if none was created,
+     *   also if a configured LED was bound to its device.
+     */
+
+    phosphor::led::Physical* createLEDPath(const std::string& ledName,
+                                           bool deferSignals = false);
+
+    /**
+     *   @brief Finds the LED of a DBus name.
+     *
+     *   @param[in] name - DBus name of the LED.
+     *
+     *   @return the position of the LED, or where it belongs.
+     */
+
+    std::vector<std::unique_ptr<LedObject>>::iterator
+        findLED(const std::string& name);
+
+    /**
+     *   @brief Systemd bus callback resolving the interface object of an
+     *   LED for the fallback vtables.
+     */
+
+    static int findInterface(sd_bus* bus, const char* path,
+                             const char* interface, void* context,
+                             void** found, sd_bus_error* error);
+
+    /**
+     *   @brief Attaches the LED to the shared services and the
+     *   ObjectManager.
+     *
+     *   @param[in] object       - the LED object.
+     *   @param[in] deferSignals - hold off the InterfacesAdded signal
      */
 
-    void createLEDPath(const std::string& ledName);
+    void attachLED(LedObject& object, bool deferSignals);
+
+    /**
+     *   @brief Binds a configured LED to its sysfs device.
+     *
+     *   The object was announced when it was created, only a
+     *   multicolor interface appearing now is signalled.
+     *
+     *   @param[in] entry - the configured LED.
+     *   @param[in] led   - the sysfs LED.
+     */
+
+    void bindLED(const phosphor::led::LedConfig::Entry& entry,
+                 std::unique_ptr<phosphor::led::SysfsLed> led);
+
+    /**
+     *   @brief Collects the interfaces of an LED for the ObjectManager.
+     *
+     *   @param[in] object - the LED object.
+     */
+
+    static std::vector<ObjectManager::Interface>
+        getInterfaces(LedObject& object);
+
+    /**
+     *   @brief Emits the held back InterfacesAdded signals, one per LED.
+     *
+     *   Only the flush is batched: the bus is flushed every
+     *   signalBatchSize objects, so a large enumeration never queues
+     *   more than about signalBudget bytes towards the broker at a time.
+     *
+     *   @param[in] pending - LEDs created with deferred signals.
+     */
+
+    void emitObjectsAdded(const std::vector<phosphor::led::Physical*>& pending);
+
+    /** @brief Budget in bytes of queued InterfacesAdded signals */
+    static constexpr size_t signalBudget = 64 * 1024;
+
+    /** @brief Rough size of one InterfacesAdded signal of a LED */
+    static constexpr size_t signalSize = 512;
+
+    static constexpr size_t signalBatchSize = signalBudget / signalSize;
 };
 
 } // namespace interface
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "monitor_interface.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace phosphor
+{
+namespace led
+{
+namespace sysfs
+{
+namespace interface
+{
+
+MonitorInterface::MonitorInterface(sdbusplus::bus_t& bus, const char* path,
+                                   const phosphor::led::LagMonitor& monitor) :
+    monitor(monitor),
+    serverInterface(bus, path, monitorInterface, vtable.data(), this)
+{}
+
+int MonitorInterface::getProperty(
+    sd_bus* /*bus*/, const char* /*path*/, const char* /*interface*/,
+    const char* property, sd_bus_message* reply, void* context,
+    sd_bus_error* error)
+{
+    if (reply == nullptr || context == nullptr)
+    {
+        lg2::error("Unable to get monitor property");
+        return -EINVAL;
+    }
+
+    try
+    {
+        const auto& monitor = static_cast<MonitorInterface*>(context)->monitor;
+        auto m = sdbusplus::message_t(reply);
+        std::string_view name(property);
+
+        if (name == "LagHistogram")
+        {
+            const auto& histogram = monitor.getLagHistogram();
+            m.append(std::vector<uint64_t>(histogram.begin(), histogram.end()));
+        }
+        else if (name == "WriteHistogram")
+        {
+            const auto& histogram = monitor.getWriteHistogram();
+            m.append(std::vector<uint64_t>(histogram.begin(), histogram.end()));
+        }
+        else if (name == "DispatchHistogram")
+        {
+            const auto& histogram = monitor.getDispatchHistogram();
+            m.append(std::vector<uint64_t>(histogram.begin(), histogram.end()));
+        }
+        else if (name == "MaxLag")
+        {
+            m.append(static_cast<uint64_t>(monitor.getMaxLag().count()));
+        }
+        else if (name == "MaxDispatch")
+        {
+            m.append(static_cast<uint64_t>(monitor.getMaxDispatch().count()));
+        }
+        else
+        {
+            std::vector<std::tuple<std::string, uint64_t>> offenders;
+            for (const auto& offender : monitor.getOffenders())
+            {
+                offenders.emplace_back(
+                    offender.name,
+                    static_cast<uint64_t>(offender.duration.count()));
+            }
+            m.append(offenders);
+        }
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        return sd_bus_error_set(error, e.name(), e.description());
+    }
+
+    return 1;
+}
+
+const std::array<sdbusplus::vtable::vtable_t, 8> MonitorInterface::vtable = {
+    sdbusplus::vtable::start(),
+    // Dispatch lag of the event loop by power of two milliseconds
+    sdbusplus::vtable::property("LagHistogram", "at", getProperty,
+                                sdbusplus::vtable::property_::none),
+    // Duration of State writes by power of two milliseconds
+    sdbusplus::vtable::property("WriteHistogram", "at", getProperty,
+                                sdbusplus::vtable::property_::none),
+    // Duration of event handlers by power of two milliseconds
+    sdbusplus::vtable::property("DispatchHistogram", "at", getProperty,
+                                sdbusplus::vtable::property_::none),
+    // Largest dispatch lag in microseconds
+    sdbusplus::vtable::property("MaxLag", "t", getProperty,
+                                sdbusplus::vtable::property_::none),
+    // Longest event handler in microseconds
+    sdbusplus::vtable::property("MaxDispatch", "t", getProperty,
+                                sdbusplus::vtable::property_::none),
+    // LEDs with the slowest writes and their duration in microseconds
+    sdbusplus::vtable::property("SlowestWrites", "a(st)", getProperty,
+                                sdbusplus::vtable::property_::none),
+    sdbusplus::vtable::end()};
+
+} // namespace interface
+} // namespace sysfs
+} // namespace led
+} // namespace phosphor
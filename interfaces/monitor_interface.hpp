@@ -0,0 +1,85 @@
+#pragma once
+
+#include "lag_monitor.hpp"
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <array>
+
+static constexpr auto monitorInterface =
+    "xyz.openbmc_project.Led.Sysfs.Monitor";
+
+namespace phosphor
+{
+namespace led
+{
+namespace sysfs
+{
+namespace interface
+{
+
+/** @class MonitorInterface
+ *  @brief Exposes the dispatch lag of the controller and its slowest LEDs
+ *
+ *  The histograms count durations by power of two milliseconds, see
+ *  LagMonitor::Histogram. The properties change all the time, they are
+ *  not announced by PropertiesChanged.
+ */
+class MonitorInterface
+{
+  public:
+    MonitorInterface() = delete;
+    MonitorInterface(const MonitorInterface&) = delete;
+    MonitorInterface& operator=(const MonitorInterface&) = delete;
+    MonitorInterface(MonitorInterface&&) = delete;
+    MonitorInterface& operator=(MonitorInterface&&) = delete;
+    ~MonitorInterface() = default;
+
+    /**
+     *  @brief Construct a class to put object onto bus at a dbus path.
+     *
+     *  @param[in] bus     - D-Bus object.
+     *  @param[in] path    - D-Bus Path of the controller.
+     *  @param[in] monitor - the lag monitor of the controller.
+     */
+
+    MonitorInterface(sdbusplus::bus_t& bus, const char* path,
+                     const phosphor::led::LagMonitor& monitor);
+
+  private:
+    /**
+     *  @brief The lag monitor of the controller.
+     */
+
+    const phosphor::led::LagMonitor& monitor;
+
+    /**
+     *  @brief Systemd bus callback for the properties.
+     */
+
+    static int getProperty(sd_bus* bus, const char* path,
+                           const char* interface, const char* property,
+                           sd_bus_message* reply, void* context,
+                           sd_bus_error* error);
+
+    /**
+     *  @brief Systemd vtable structure that contains all the
+     *  methods, signals, and properties of this interface with their
+     *  respective systemd attributes
+     */
+
+    static const std::array<sdbusplus::vtable::vtable_t, 8> vtable;
+
+    /**
+     *  @brief Support for the dbus based instance of this interface.
+     */
+
+    sdbusplus::server::interface_t serverInterface;
+};
+
+} // namespace interface
+} // namespace sysfs
+} // namespace led
+} // namespace phosphor
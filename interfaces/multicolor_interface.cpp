@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "multicolor_interface.hpp"
+
+#include "fallback_vtable.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <map>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace phosphor
+{
+namespace led
+{
+namespace sysfs
+{
+namespace interface
+{
+
+MultiColorInterface::MultiColorInterface(sdbusplus::bus_t& bus,
+                                         const std::string& path,
+                                         phosphor::led::Physical& led) :
+    bus(bus), path(path), led(led)
+{}
+
+sdbusplus::slot_t MultiColorInterface::serve(sdbusplus::bus_t& bus,
+                                             const char* parent,
+                                             sd_bus_object_find_t find,
+                                             void* context)
+{
+    return addFallbackVtable(bus, parent, multiColorInterface, vtable.data(),
+                             find, context);
+}
+
+std::vector<uint32_t> MultiColorInterface::getIntensity() const
+{
+    const auto& intensity = led.getMultiColor()->intensity;
+    return {intensity.begin(), intensity.end()};
+}
+
+void MultiColorInterface::appendProperties(sdbusplus::message_t& m) const
+{
+    using Value = std::variant<std::vector<std::string>, std::vector<uint32_t>>;
+
+    m.append(std::map<std::string, Value>{
+        {"Channels", led.getMultiColor()->channels},
+        {"Intensity", getIntensity()},
+    });
+}
+
+int MultiColorInterface::getProperty(
+    sd_bus* /*bus*/, const char* /*path*/, const char* /*interface*/,
+    const char* property, sd_bus_message* reply, void* context,
+    sd_bus_error* error)
+{
+    if (reply == nullptr || context == nullptr)
+    {
+        lg2::error("Unable to get multicolor property");
+        return -EINVAL;
+    }
+
+    try
+    {
+        auto* self = static_cast<MultiColorInterface*>(context);
+        auto m = sdbusplus::message_t(reply);
+
+        if (std::string_view(property) == "Channels")
+        {
+            m.append(self->led.getMultiColor()->channels);
+        }
+        else
+        {
+            m.append(self->getIntensity());
+        }
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        return sd_bus_error_set(error, e.name(), e.description());
+    }
+
+    return 1;
+}
+
+int MultiColorInterface::setIntensity(
+    sd_bus* /*bus*/, const char* /*path*/, const char* /*interface*/,
+    const char* /*property*/, sd_bus_message* value, void* context,
+    sd_bus_error* error)
+{
+    if (value == nullptr || context == nullptr)
+    {
+        lg2::error("Unable to set intensity");
+        return -EINVAL;
+    }
+
+    try
+    {
+        auto* self = static_cast<MultiColorInterface*>(context);
+        auto m = sdbusplus::message_t(value);
+        auto intensity = m.unpack<std::vector<uint32_t>>();
+
+        self->led.setIntensity({intensity.begin(), intensity.end()});
+        sd_bus_emit_properties_changed(self->bus.get(), self->path.c_str(),
+                                       multiColorInterface, "Intensity",
+                                       nullptr);
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        return sd_bus_error_set(error, e.name(), e.description());
+    }
+
+    return 1;
+}
+
+int MultiColorInterface::setColorConfigure(sd_bus_message* msg, void* context,
+                                           sd_bus_error* error)
+{
+    if (msg == nullptr && context == nullptr)
+    {
+        lg2::error("Unable to configure setColor");
+        return -EINVAL;
+    }
+
+    try
+    {
+        auto message = sdbusplus::message_t(msg);
+        auto [red, green, blue] =
+            message.unpack<uint8_t, uint8_t, uint8_t>();
+
+        auto* self = static_cast<MultiColorInterface*>(context);
+        self->led.setColor(red, green, blue);
+        sd_bus_emit_properties_changed(self->bus.get(), self->path.c_str(),
+                                       multiColorInterface, "Intensity",
+                                       nullptr);
+
+        auto reply = message.new_method_return();
+        reply.method_return();
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        return sd_bus_error_set(error, e.name(), e.description());
+    }
+
+    return 1;
+}
+
+const std::array<sdbusplus::vtable::vtable_t, 5> MultiColorInterface::vtable =
+    {sdbusplus::vtable::start(),
+     // Channel colors as listed in multi_index
+     sdbusplus::vtable::property("Channels", "as", getProperty,
+                                 sdbusplus::vtable::property_::const_),
+     // Intensity of each channel, up to max_brightness
+     sdbusplus::vtable::property("Intensity", "au", getProperty, setIntensity,
+                                 sdbusplus::vtable::property_::emits_change),
+     // SetColor takes red, green and blue and returns void
+     sdbusplus::vtable::method("SetColor", "yyy", "", setColorConfigure),
+     sdbusplus::vtable::end()};
+
+} // namespace interface
+} // namespace sysfs
+} // namespace led
+} // namespace phosphor
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "physical.hpp"
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/slot.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <array>
+#include <string>
+
+static constexpr auto multiColorInterface =
+    "xyz.openbmc_project.Led.Sysfs.MultiColor";
+
+namespace phosphor
+{
+namespace led
+{
+namespace sysfs
+{
+namespace interface
+{
+
+/** @class MultiColorInterface
+ *  @brief Exposes the channels of a multicolor LED
+ *
+ *  Only hosted on LEDs of the kernel leds-class-multicolor. The channel
+ *  intensities are written with a single multi_intensity write.
+ */
+class MultiColorInterface
+{
+  public:
+    MultiColorInterface() = delete;
+    MultiColorInterface(const MultiColorInterface&) = delete;
+    MultiColorInterface& operator=(const MultiColorInterface&) = delete;
+    MultiColorInterface(MultiColorInterface&&) = delete;
+    MultiColorInterface& operator=(MultiColorInterface&&) = delete;
+    ~MultiColorInterface() = default;
+
+    /**
+     *  @brief Construct the interface of an LED, it is served by serve().
+     *
+     *  @param[in] bus  - D-Bus object.
+     *  @param[in] path - D-Bus Path of the LED, it has to outlive the
+     *                    interface.
+     *  @param[in] led  - the LED.
+     */
+
+    MultiColorInterface(sdbusplus::bus_t& bus, const std::string& path,
+                        phosphor::led::Physical& led);
+
+    /**
+     *  @brief Serves the interface of all LEDs with one registration.
+     *
+     *  @param[in] bus     - D-Bus object.
+     *  @param[in] parent  - path the LEDs are below.
+     *  @param[in] find    - resolves the interface object of an LED.
+     *  @param[in] context - passed to find.
+     *
+     *  @return the registration, the interface is served while it lives.
+     */
+
+    static sdbusplus::slot_t serve(sdbusplus::bus_t& bus, const char* parent,
+                                   sd_bus_object_find_t find, void* context);
+
+    /**
+     *  @brief Appends the properties of the interface as a{sv}.
+     *
+     *  @param[in] m - message to append to.
+     */
+
+    void appendProperties(sdbusplus::message_t& m) const;
+
+  private:
+    /**
+     *  @brief D-Bus object sending the PropertiesChanged signals.
+     */
+
+    sdbusplus::bus_t& bus;
+
+    /**
+     *  @brief D-Bus Path of the LED.
+     */
+
+    const std::string& path;
+
+    /**
+     *  @brief The LED.
+     */
+
+    phosphor::led::Physical& led;
+
+    /**
+     *  @brief Current intensities as sent on D-Bus.
+     */
+
+    std::vector<uint32_t> getIntensity() const;
+
+    /**
+     *  @brief Systemd bus callback for the properties.
+     */
+
+    static int getProperty(sd_bus* bus, const char* path,
+                           const char* interface, const char* property,
+                           sd_bus_message* reply, void* context,
+                           sd_bus_error* error);
+
+    /**
+     *  @brief Systemd bus callback for setting Intensity.
+     */
+
+    static int setIntensity(sd_bus* bus, const char* path,
+                            const char* interface, const char* property,
+                            sd_bus_message* value, void* context,
+                            sd_bus_error* error);
+
+    /**
+     *  @brief Systemd bus callback for the SetColor method.
+     */
+
+    static int setColorConfigure(sd_bus_message* msg, void* context,
+                                 sd_bus_error* error);
+
+    /**
+     *  @brief Systemd vtable structure that contains all the
+     *  methods, signals, and properties of this interface with their
+     *  respective systemd attributes
+     */
+
+    static const std::array<sdbusplus::vtable::vtable_t, 5> vtable;
+};
+
+} // namespace interface
+} // namespace sysfs
+} // namespace led
+} // namespace phosphor
@@ -0,0 +1,201 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "object_manager.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/exception.hpp>
+
+#include <array>
+#include <cstring>
+
+namespace phosphor
+{
+namespace led
+{
+namespace sysfs
+{
+namespace interface
+{
+
+static constexpr auto objectManagerInterface =
+    "org.freedesktop.DBus.ObjectManager";
+
+// sd-bus reports these for every object, without properties
+static constexpr std::array<const char*, 3> standardInterfaces = {
+    "org.freedesktop.DBus.Peer",
+    "org.freedesktop.DBus.Introspectable",
+    "org.freedesktop.DBus.Properties",
+};
+
+ObjectManager::ObjectManager(sdbusplus::bus_t& bus, const char* path,
+                             bool cache) :
+    bus(bus), path(path), manager(bus, path)
+{
+    if (!cache)
+    {
+        return;
+    }
+
+    sd_bus_slot* slot = nullptr;
+    int rc = sd_bus_add_filter(bus.get(), &slot, filter, this);
+    if (rc < 0)
+    {
+        lg2::error("Unable to add GetManagedObjects filter: {RC}", "RC", rc);
+        return;
+    }
+
+    filterSlot.emplace(slot);
+}
+
+void ObjectManager::add(const std::string& path,
+                        std::vector<Interface> interfaces)
+{
+    entries.insert_or_assign(path, Entry{std::move(interfaces), std::nullopt});
+}
+
+void ObjectManager::remove(const std::string& path)
+{
+    entries.erase(path);
+}
+
+void ObjectManager::invalidate(const std::string& path)
+{
+    auto it = entries.find(path);
+    if (it != entries.end())
+    {
+        it->second.fragment.reset();
+    }
+}
+
+namespace
+{
+
+/** @brief Throws if an sd-bus call failed, the filter then lets sd-bus
+ *   build the reply instead
+ */
+void check(int rc, const char* call)
+{
+    if (rc < 0)
+    {
+        throw sdbusplus::exception::SdBusError(-rc, call);
+    }
+}
+
+} // namespace
+
+void ObjectManager::serialize(const std::string& path, Entry& entry)
+{
+    // Any unsent message will do as a container for the fragment
+    auto fragment =
+        bus.new_signal(path.c_str(), objectManagerInterface, "Fragment");
+    auto* m = fragment.get();
+
+    fragment.append(sdbusplus::message::object_path(path));
+
+    check(sd_bus_message_open_container(m, SD_BUS_TYPE_ARRAY, "{sa{sv}}"),
+          "sd_bus_message_open_container");
+    for (const auto& [name, appender] : entry.interfaces)
+    {
+        check(sd_bus_message_open_container(m, SD_BUS_TYPE_DICT_ENTRY,
+                                            "sa{sv}"),
+              "sd_bus_message_open_container");
+        fragment.append(name);
+        appender(fragment);
+        check(sd_bus_message_close_container(m),
+              "sd_bus_message_close_container");
+    }
+    for (const auto* name : standardInterfaces)
+    {
+        check(sd_bus_message_open_container(m, SD_BUS_TYPE_DICT_ENTRY,
+                                            "sa{sv}"),
+              "sd_bus_message_open_container");
+        check(sd_bus_message_append(m, "s", name), "sd_bus_message_append");
+        check(sd_bus_message_open_container(m, SD_BUS_TYPE_ARRAY, "{sv}"),
+              "sd_bus_message_open_container");
+        check(sd_bus_message_close_container(m),
+              "sd_bus_message_close_container");
+        check(sd_bus_message_close_container(m),
+              "sd_bus_message_close_container");
+    }
+    check(sd_bus_message_close_container(m), "sd_bus_message_close_container");
+
+    // Only sealed messages can be read back
+    check(sd_bus_message_seal(m, 1, 0), "sd_bus_message_seal");
+
+    entry.fragment.emplace(std::move(fragment));
+}
+
+void ObjectManager::reply(sd_bus_message* msg)
+{
+    auto call = sdbusplus::message_t(msg);
+    auto reply = call.new_method_return();
+    auto* m = reply.get();
+
+    check(sd_bus_message_open_container(m, SD_BUS_TYPE_ARRAY, "{oa{sa{sv}}}"),
+          "sd_bus_message_open_container");
+    for (auto& [objPath, entry] : entries)
+    {
+        if (!entry.fragment)
+        {
+            serialize(objPath, entry);
+        }
+
+        auto* fragment = entry.fragment->get();
+        check(sd_bus_message_rewind(fragment, 1), "sd_bus_message_rewind");
+
+        check(sd_bus_message_open_container(m, SD_BUS_TYPE_DICT_ENTRY,
+                                            "oa{sa{sv}}"),
+              "sd_bus_message_open_container");
+        check(sd_bus_message_copy(m, fragment, 1), "sd_bus_message_copy");
+        check(sd_bus_message_close_container(m),
+              "sd_bus_message_close_container");
+    }
+    check(sd_bus_message_close_container(m), "sd_bus_message_close_container");
+
+    // Nothing is sent unless the whole reply could be built
+    reply.method_return();
+}
+
+int ObjectManager::filter(sd_bus_message* msg, void* context,
+                          sd_bus_error* /*error*/)
+{
+    if (msg == nullptr || context == nullptr)
+    {
+        return 0;
+    }
+
+    auto* self = static_cast<ObjectManager*>(context);
+
+    if (sd_bus_message_is_method_call(msg, objectManagerInterface,
+                                      "GetManagedObjects") <= 0)
+    {
+        return 0;
+    }
+
+    const char* msgPath = sd_bus_message_get_path(msg);
+    if (msgPath == nullptr || self->path != msgPath)
+    {
+        return 0;
+    }
+
+    try
+    {
+        self->reply(msg);
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        lg2::error("Unable to reply to GetManagedObjects: {ERROR}", "ERROR",
+                   e);
+        // Let sd-bus answer it the slow way
+        return 0;
+    }
+
+    // Handled, sd-bus must not dispatch it any further
+    return 1;
+}
+
+} // namespace interface
+} // namespace sysfs
+} // namespace led
+} // namespace phosphor
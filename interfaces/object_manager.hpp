@@ -0,0 +1,153 @@
+#pragma once
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/message.hpp>
+#include <sdbusplus/server/manager.hpp>
+#include <sdbusplus/slot.hpp>
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phosphor
+{
+namespace led
+{
+namespace sysfs
+{
+namespace interface
+{
+
+/** @class ObjectManager
+ *  @brief ObjectManager answering GetManagedObjects from a cache
+ *
+ *  sd-bus builds the GetManagedObjects reply by walking every object and
+ *  calling every property getter. This class intercepts the method call at
+ *  the manager path and assembles the reply from per-object fragments which
+ *  are serialized once and only rebuilt after the object was invalidated.
+ *  InterfacesAdded/Removed are still sent by the wrapped sd-bus manager.
+ */
+class ObjectManager
+{
+  public:
+    ObjectManager() = delete;
+    ~ObjectManager() = default;
+    ObjectManager(const ObjectManager&) = delete;
+    ObjectManager& operator=(const ObjectManager&) = delete;
+    ObjectManager(ObjectManager&&) = delete;
+    ObjectManager& operator=(ObjectManager&&) = delete;
+
+    /** @brief Appends the a{sv} property dictionary of an interface */
+    using Appender = std::function<void(sdbusplus::message_t&)>;
+
+    /** @brief Interface name and its property appender, the name is one
+     *   of the static interface name constants
+     */
+    using Interface = std::pair<const char*, Appender>;
+
+    /**
+     *  @brief Construct the manager at a dbus path.
+     *
+     *  @param[in] bus   - D-Bus object.
+     *  @param[in] path  - D-Bus Path.
+     *  @param[in] cache - answer GetManagedObjects from the cache
+     */
+
+    ObjectManager(sdbusplus::bus_t& bus, const char* path, bool cache = true);
+
+    /**
+     *  @brief Adds an object to the cache.
+     *
+     *  @param[in] path       - object path.
+     *  @param[in] interfaces - interfaces implemented by the object.
+     */
+
+    void add(const std::string& path, std::vector<Interface> interfaces);
+
+    /**
+     *  @brief Removes an object from the cache.
+     *
+     *  @param[in] path - object path.
+     */
+
+    void remove(const std::string& path);
+
+    /**
+     *  @brief Marks the cached fragment of an object as stale.
+     *
+     *  @param[in] path - object path.
+     */
+
+    void invalidate(const std::string& path);
+
+  private:
+    /** @brief Cached state of one object */
+    struct Entry
+    {
+        std::vector<Interface> interfaces;
+
+        /** @brief Sealed message holding the oa{sa{sv}} of the object */
+        std::optional<sdbusplus::message_t> fragment;
+    };
+
+    /**
+     *  @brief sdbusplus D-Bus connection.
+     */
+
+    sdbusplus::bus_t& bus;
+
+    /**
+     *  @brief Path of the manager.
+     */
+
+    std::string path;
+
+    /**
+     *  @brief The sd-bus manager, emitting InterfacesAdded/Removed.
+     */
+
+    sdbusplus::server::manager_t manager;
+
+    /**
+     *  @brief Slot of the message filter, empty if caching is disabled.
+     */
+
+    std::optional<sdbusplus::slot_t> filterSlot;
+
+    /**
+     *  @brief Cached objects by path.
+     */
+
+    std::map<std::string, Entry> entries;
+
+    /**
+     *  @brief Serializes the fragment of one object.
+     *
+     *  @param[in] path  - object path.
+     *  @param[in] entry - the object.
+     */
+
+    void serialize(const std::string& path, Entry& entry);
+
+    /**
+     *  @brief Replies to a GetManagedObjects call from the cache.
+     *
+     *  @param[in] msg - the method call.
+     */
+
+    void reply(sd_bus_message* msg);
+
+    /**
+     *  @brief Systemd bus filter catching GetManagedObjects at our path.
+     */
+
+    static int filter(sd_bus_message* msg, void* context, sd_bus_error* error);
+};
+
+} // namespace interface
+} // namespace sysfs
+} // namespace led
+} // namespace phosphor
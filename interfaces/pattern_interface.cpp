@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "pattern_interface.hpp"
+
+#include "fallback_vtable.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <tuple>
+#include <vector>
+
+namespace phosphor
+{
+namespace led
+{
+namespace sysfs
+{
+namespace interface
+{
+
+PatternInterface::PatternInterface(phosphor::led::Physical& led) : led(led)
+{}
+
+sdbusplus::slot_t PatternInterface::serve(sdbusplus::bus_t& bus,
+                                          const char* parent,
+                                          sd_bus_object_find_t find,
+                                          void* context)
+{
+    return addFallbackVtable(bus, parent, patternInterface, vtable.data(),
+                             find, context);
+}
+
+int PatternInterface::setPatternConfigure(sd_bus_message* msg, void* context,
+                                          sd_bus_error* error)
+{
+    if (msg == nullptr && context == nullptr)
+    {
+        lg2::error("Unable to configure setPattern");
+        return -EINVAL;
+    }
+
+    try
+    {
+        auto message = sdbusplus::message_t(msg);
+        auto [steps, repeat] = message.unpack<
+            std::vector<std::tuple<uint8_t, uint16_t>>, int32_t>();
+
+        phosphor::led::Pattern pattern;
+        pattern.reserve(steps.size());
+        for (const auto& [brightness, duration] : steps)
+        {
+            pattern.emplace_back(brightness, duration);
+        }
+
+        auto* self = static_cast<PatternInterface*>(context);
+        self->led.setPattern(pattern, repeat);
+
+        auto reply = message.new_method_return();
+        reply.method_return();
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        return sd_bus_error_set(error, e.name(), e.description());
+    }
+
+    return 1;
+}
+
+int PatternInterface::stopPatternConfigure(sd_bus_message* msg, void* context,
+                                           sd_bus_error* error)
+{
+    if (msg == nullptr && context == nullptr)
+    {
+        lg2::error("Unable to configure stopPattern");
+        return -EINVAL;
+    }
+
+    try
+    {
+        auto message = sdbusplus::message_t(msg);
+
+        auto* self = static_cast<PatternInterface*>(context);
+        self->led.stopPattern();
+
+        auto reply = message.new_method_return();
+        reply.method_return();
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        return sd_bus_error_set(error, e.name(), e.description());
+    }
+
+    return 1;
+}
+
+int PatternInterface::pulseConfigure(sd_bus_message* msg, void* context,
+                                     sd_bus_error* error)
+{
+    if (msg == nullptr && context == nullptr)
+    {
+        lg2::error("Unable to configure pulse");
+        return -EINVAL;
+    }
+
+    try
+    {
+        auto message = sdbusplus::message_t(msg);
+        auto duration = message.unpack<uint16_t>();
+
+        auto* self = static_cast<PatternInterface*>(context);
+        self->led.pulse(duration);
+
+        auto reply = message.new_method_return();
+        reply.method_return();
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        return sd_bus_error_set(error, e.name(), e.description());
+    }
+
+    return 1;
+}
+
+const std::array<sdbusplus::vtable::vtable_t, 5> PatternInterface::vtable = {
+    sdbusplus::vtable::start(),
+    // SetPattern takes (brightness percent, duration ms) steps and a repeat
+    // count, -1 repeats forever, and returns void
+    sdbusplus::vtable::method("SetPattern", "a(yq)i", "", setPatternConfigure),
+    // StopPattern returns the LED to its State
+    sdbusplus::vtable::method("StopPattern", "", "", stopPatternConfigure),
+    // Pulse takes the duration in milliseconds and returns void
+    sdbusplus::vtable::method("Pulse", "q", "", pulseConfigure),
+    sdbusplus::vtable::end()};
+
+} // namespace interface
+} // namespace sysfs
+} // namespace led
+} // namespace phosphor
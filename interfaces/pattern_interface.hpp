@@ -0,0 +1,101 @@
+#pragma once
+
+#include "physical.hpp"
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/slot.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <array>
+
+static constexpr auto patternInterface = "xyz.openbmc_project.Led.Sysfs.Pattern";
+
+namespace phosphor
+{
+namespace led
+{
+namespace sysfs
+{
+namespace interface
+{
+
+/** @class PatternInterface
+ *  @brief Plays blink patterns on a LED
+ *
+ *  A pattern is a sequence of (brightness, duration) steps, e.g. fault
+ *  codes like "two short, one long" that Period and DutyOn cannot express.
+ *  A pulse flips the LED once, e.g. to indicate activity.
+ */
+class PatternInterface
+{
+  public:
+    PatternInterface() = delete;
+    PatternInterface(const PatternInterface&) = delete;
+    PatternInterface& operator=(const PatternInterface&) = delete;
+    PatternInterface(PatternInterface&&) = delete;
+    PatternInterface& operator=(PatternInterface&&) = delete;
+    ~PatternInterface() = default;
+
+    /**
+     *  @brief Construct the interface of an LED, it is served by serve().
+     *
+     *  @param[in] led - the LED.
+     */
+
+    explicit PatternInterface(phosphor::led::Physical& led);
+
+    /**
+     *  @brief Serves the interface of all LEDs with one registration.
+     *
+     *  @param[in] bus     - D-Bus object.
+     *  @param[in] parent  - path the LEDs are below.
+     *  @param[in] find    - resolves the interface object of an LED.
+     *  @param[in] context - passed to find.
+     *
+     *  @return the registration, the interface is served while it lives.
+     */
+
+    static sdbusplus::slot_t serve(sdbusplus::bus_t& bus, const char* parent,
+                                   sd_bus_object_find_t find, void* context);
+
+  private:
+    /**
+     *  @brief The LED.
+     */
+
+    phosphor::led::Physical& led;
+
+    /**
+     *  @brief Systemd bus callback for the SetPattern method.
+     */
+
+    static int setPatternConfigure(sd_bus_message* msg, void* context,
+                                   sd_bus_error* error);
+
+    /**
+     *  @brief Systemd bus callback for the StopPattern method.
+     */
+
+    static int stopPatternConfigure(sd_bus_message* msg, void* context,
+                                    sd_bus_error* error);
+
+    /**
+     *  @brief Systemd bus callback for the Pulse method.
+     */
+
+    static int pulseConfigure(sd_bus_message* msg, void* context,
+                              sd_bus_error* error);
+
+    /**
+     *  @brief Systemd vtable structure that contains all the
+     *  methods, signals, and properties of this interface with their
+     *  respective systemd attributes
+     */
+
+    static const std::array<sdbusplus::vtable::vtable_t, 5> vtable;
+};
+
+} // namespace interface
+} // namespace sysfs
+} // namespace led
+} // namespace phosphor
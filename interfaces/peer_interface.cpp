@@ -0,0 +1,175 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "peer_interface.hpp"
+
+#include "fallback_vtable.hpp"
+#include "internal_interface.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <string_view>
+
+namespace phosphor
+{
+namespace led
+{
+namespace sysfs
+{
+namespace interface
+{
+
+PeerInterface::PeerInterface(sdbusplus::bus_t& bus,
+                             InternalInterface& internal) :
+    internal(internal), internalSlot(internal.servePeer(bus)),
+    physicalSlot(addPhysical(bus))
+{}
+
+sdbusplus::slot_t PeerInterface::addPhysical(sdbusplus::bus_t& bus)
+{
+    return addFallbackVtable(bus, physParent, physicalInterface, vtable.data(),
+                             find, this);
+}
+
+std::optional<std::string_view>
+    PeerInterface::objectName(std::string_view path)
+{
+    // Only the objects right below physParent are LEDs or groups
+    std::string_view prefix(physParent);
+    if (!path.starts_with(prefix) || path.size() <= prefix.size() + 1 ||
+        path[prefix.size()] != '/')
+    {
+        return std::nullopt;
+    }
+
+    auto name = path.substr(prefix.size() + 1);
+    if (name.find('/') != std::string_view::npos)
+    {
+        return std::nullopt;
+    }
+
+    return name;
+}
+
+int PeerInterface::find(sd_bus* /*bus*/, const char* path,
+                        const char* /*interface*/, void* context,
+                        void** found, sd_bus_error* /*error*/)
+{
+    auto* self = static_cast<PeerInterface*>(context);
+
+    auto name = objectName(path);
+    if (!name)
+    {
+        return 0;
+    }
+
+    auto* object = self->internal.findObject(*name);
+    if (object == nullptr)
+    {
+        return 0;
+    }
+
+    *found = object;
+    return 1;
+}
+
+int PeerInterface::getProperty(sd_bus* /*bus*/, const char* /*path*/,
+                               const char* /*interface*/,
+                               const char* property, sd_bus_message* reply,
+                               void* context, sd_bus_error* error)
+{
+    if (reply == nullptr || context == nullptr)
+    {
+        lg2::error("Unable to get peer property");
+        return -EINVAL;
+    }
+
+    try
+    {
+        auto* led = static_cast<PhysicalServer*>(context);
+        auto m = sdbusplus::message_t(reply);
+        std::string_view name(property);
+
+        if (name == "State")
+        {
+            m.append(PhysicalServer::convertActionToString(led->state()));
+        }
+        else if (name == "DutyOn")
+        {
+            m.append(led->dutyOn());
+        }
+        else if (name == "Period")
+        {
+            m.append(led->period());
+        }
+        else
+        {
+            m.append(PhysicalServer::convertPaletteToString(led->color()));
+        }
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        return sd_bus_error_set(error, e.name(), e.description());
+    }
+
+    return 1;
+}
+
+int PeerInterface::setProperty(sd_bus* /*bus*/, const char* /*path*/,
+                               const char* /*interface*/,
+                               const char* property, sd_bus_message* value,
+                               void* context, sd_bus_error* error)
+{
+    if (value == nullptr || context == nullptr)
+    {
+        lg2::error("Unable to set peer property");
+        return -EINVAL;
+    }
+
+    try
+    {
+        auto* led = static_cast<PhysicalServer*>(context);
+        auto m = sdbusplus::message_t(value);
+        std::string_view name(property);
+
+        // The setters send PropertiesChanged on the bus as usual
+        if (name == "State")
+        {
+            led->state(PhysicalServer::convertActionFromString(
+                m.unpack<std::string>()));
+        }
+        else if (name == "DutyOn")
+        {
+            led->dutyOn(m.unpack<uint8_t>());
+        }
+        else
+        {
+            led->period(m.unpack<uint16_t>());
+        }
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        return sd_bus_error_set(error, e.name(), e.description());
+    }
+
+    return 1;
+}
+
+const std::array<sdbusplus::vtable::vtable_t, 6> PeerInterface::vtable = {
+    sdbusplus::vtable::start(),
+    sdbusplus::vtable::property("State", "s", getProperty, setProperty,
+                                sdbusplus::vtable::property_::none),
+    sdbusplus::vtable::property("DutyOn", "y", getProperty, setProperty,
+                                sdbusplus::vtable::property_::none),
+    sdbusplus::vtable::property("Period", "q", getProperty, setProperty,
+                                sdbusplus::vtable::property_::none),
+    sdbusplus::vtable::property("Color", "s", getProperty,
+                                sdbusplus::vtable::property_::const_),
+    sdbusplus::vtable::end()};
+
+} // namespace interface
+} // namespace sysfs
+} // namespace led
+} // namespace phosphor
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/slot.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <array>
+#include <optional>
+#include <string_view>
+
+namespace phosphor
+{
+namespace led
+{
+namespace sysfs
+{
+namespace interface
+{
+
+class InternalInterface;
+
+/** @class PeerInterface
+ *  @brief Serves the controller on a direct peer to peer connection
+ *
+ *  The internal interface is served on its path. The Physical interface
+ *  of every LED and group is served by a single fallback vtable below
+ *  physParent, which resolves the object on each call, so LEDs added
+ *  later are reachable without registering them per connection. Peers
+ *  receive no signals, PropertiesChanged is only sent on the bus.
+ */
+class PeerInterface
+{
+  public:
+    PeerInterface() = delete;
+    PeerInterface(const PeerInterface&) = delete;
+    PeerInterface& operator=(const PeerInterface&) = delete;
+    PeerInterface(PeerInterface&&) = delete;
+    PeerInterface& operator=(PeerInterface&&) = delete;
+    ~PeerInterface() = default;
+
+    /**
+     *  @brief Serves the objects on a peer connection.
+     *
+     *  @param[in] bus      - the peer connection.
+     *  @param[in] internal - the controller.
+     */
+
+    PeerInterface(sdbusplus::bus_t& bus, InternalInterface& internal);
+
+    /**
+     *  @brief Name of the LED or group a path is served for.
+     *
+     *  @param[in] path - the object path.
+     *
+     *  @return the name, nullopt unless the path is right below
+     *          physParent.
+     */
+
+    static std::optional<std::string_view> objectName(std::string_view path);
+
+  private:
+    /**
+     *  @brief The controller resolving the LEDs and groups.
+     */
+
+    InternalInterface& internal;
+
+    /**
+     *  @brief Registration of the internal interface.
+     */
+
+    sdbusplus::slot_t internalSlot;
+
+    /**
+     *  @brief Registration of the Physical fallback vtable.
+     */
+
+    sdbusplus::slot_t physicalSlot;
+
+    /**
+     *  @brief Systemd bus callback resolving the LED or group of a path.
+     */
+
+    static int find(sd_bus* bus, const char* path, const char* interface,
+                    void* context, void** found, sd_bus_error* error);
+
+    /**
+     *  @brief Systemd bus callback for the properties.
+     */
+
+    static int getProperty(sd_bus* bus, const char* path,
+                           const char* interface, const char* property,
+                           sd_bus_message* reply, void* context,
+                           sd_bus_error* error);
+
+    /**
+     *  @brief Systemd bus callback for setting the properties.
+     */
+
+    static int setProperty(sd_bus* bus, const char* path,
+                           const char* interface, const char* property,
+                           sd_bus_message* value, void* context,
+                           sd_bus_error* error);
+
+    /**
+     *  @brief Registers the Physical fallback vtable.
+     */
+
+    sdbusplus::slot_t addPhysical(sdbusplus::bus_t& bus);
+
+    /**
+     *  @brief Systemd vtable structure that contains all the
+     *  methods, signals, and properties of this interface with their
+     *  respective systemd attributes
+     */
+
+    static const std::array<sdbusplus::vtable::vtable_t, 6> vtable;
+};
+
+} // namespace interface
+} // namespace sysfs
+} // namespace led
+} // namespace phosphor
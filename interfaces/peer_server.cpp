@@ -0,0 +1,279 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "peer_server.hpp"
+
+#include "internal_interface.hpp"
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <systemd/sd-id128.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/exception.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+namespace phosphor
+{
+namespace led
+{
+namespace sysfs
+{
+namespace interface
+{
+
+namespace rules = sdbusplus::bus::match::rules;
+
+PeerServer::Connection::Connection(sdbusplus::bus_t&& bus,
+                                   InternalInterface& internal,
+                                   std::function<void()> onClose) :
+    bus(std::move(bus)), objects(this->bus, internal),
+    disconnected(this->bus,
+                 rules::type::signal() +
+                     rules::path("/org/freedesktop/DBus/Local") +
+                     rules::interface("org.freedesktop.DBus.Local") +
+                     rules::member("Disconnected"),
+                 [onClose = std::move(onClose)](sdbusplus::message_t&) {
+                     onClose();
+                 })
+{}
+
+PeerServer::PeerServer(const sdeventplus::Event& event,
+                       std::filesystem::path path,
+                       InternalInterface& internal) :
+    event(event), path(std::move(path)), internal(internal),
+    reaper(event, [this](auto&) { prune(); })
+{
+    reaper.setEnabled(false);
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (this->path.native().size() >= sizeof(address.sun_path))
+    {
+        lg2::error("Peer socket path {PATH} is too long", "PATH",
+                   this->path.string());
+        return;
+    }
+    std::strncpy(address.sun_path, this->path.c_str(),
+                 sizeof(address.sun_path) - 1);
+
+    std::error_code ec;
+    std::filesystem::create_directories(this->path.parent_path(), ec);
+
+    // A socket left over by an earlier instance would fail the bind,
+    // anything else at the path is not ours to remove
+    struct stat info{};
+    if (lstat(this->path.c_str(), &info) == 0)
+    {
+        if (!S_ISSOCK(info.st_mode))
+        {
+            lg2::error("Peer socket path {PATH} exists and is no socket",
+                       "PATH", this->path.string());
+            return;
+        }
+        unlink(this->path.c_str());
+    }
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (listenFd < 0 ||
+        bind(listenFd, reinterpret_cast<sockaddr*>(&address),
+             sizeof(address)) < 0 ||
+        chmod(this->path.c_str(), S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP) <
+            0 ||
+        listen(listenFd, SOMAXCONN) < 0)
+    {
+        lg2::error("Unable to listen for peers on {PATH}: {ERROR}", "PATH",
+                   this->path.string(), "ERROR", strerror(errno));
+        if (listenFd >= 0)
+        {
+            close(listenFd);
+            listenFd = -1;
+        }
+        return;
+    }
+
+    listener.emplace(event, listenFd, EPOLLIN,
+                     [this](auto&, int, uint32_t) { accept(); });
+}
+
+PeerServer::~PeerServer()
+{
+    listener.reset();
+    connections.clear();
+
+    if (listenFd >= 0)
+    {
+        close(listenFd);
+        unlink(path.c_str());
+    }
+}
+
+void PeerServer::accept()
+{
+    while (true)
+    {
+        int fd = accept4(listenFd, nullptr, nullptr,
+                         SOCK_CLOEXEC | SOCK_NONBLOCK);
+        if (fd < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                lg2::error("Unable to accept a peer: {ERROR}", "ERROR",
+                           strerror(errno));
+            }
+            return;
+        }
+
+        if (!checkPeer(fd))
+        {
+            close(fd);
+            continue;
+        }
+
+        try
+        {
+            connect(fd);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            lg2::error("Unable to serve a peer: {ERROR}", "ERROR", e.what());
+        }
+    }
+}
+
+sdbusplus::bus_t PeerServer::openPeer(int fd)
+{
+    sd_bus* raw = nullptr;
+    auto rc = sd_bus_new(&raw);
+    if (rc < 0)
+    {
+        close(fd);
+        throw sdbusplus::exception::SdBusError(-rc, "sd_bus_new");
+    }
+
+    // Owns the reference from sd_bus_new
+    sdbusplus::bus_t bus(raw, std::false_type());
+
+    rc = sd_bus_set_fd(raw, fd, fd);
+    if (rc < 0)
+    {
+        close(fd);
+        throw sdbusplus::exception::SdBusError(-rc, "sd_bus_set_fd");
+    }
+
+    // The credentials were checked on accept already, the peer does not
+    // have to run as the user of the controller
+    sd_id128_t id{};
+    rc = sd_id128_randomize(&id);
+    if (rc >= 0)
+    {
+        rc = sd_bus_set_server(raw, 1, id);
+    }
+    if (rc >= 0)
+    {
+        rc = sd_bus_set_anonymous(raw, 1);
+    }
+    if (rc >= 0)
+    {
+        rc = sd_bus_start(raw);
+    }
+    if (rc < 0)
+    {
+        throw sdbusplus::exception::SdBusError(-rc, "sd_bus_start");
+    }
+
+    return bus;
+}
+
+void PeerServer::connect(int fd)
+{
+    auto bus = openPeer(fd);
+    bus.attach_event(event.get(), SD_EVENT_PRIORITY_NORMAL);
+
+    auto connection = nextId++;
+    connections.emplace(connection,
+                        std::make_unique<Connection>(
+                            std::move(bus), internal, [this, connection]() {
+                                closed.emplace_back(connection);
+                                reaper.restartOnce(std::chrono::seconds(0));
+                            }));
+}
+
+bool PeerServer::isAllowed(uid_t uid, const std::vector<gid_t>& groups,
+                           std::optional<gid_t> socketGroup)
+{
+    if (uid == 0 || uid == geteuid())
+    {
+        return true;
+    }
+
+    // Access can be granted by handing the socket to a group
+    return socketGroup &&
+           std::ranges::find(groups, *socketGroup) != groups.end();
+}
+
+bool PeerServer::checkPeer(int fd) const
+{
+    ucred credentials{};
+    socklen_t size = sizeof(credentials);
+    if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &credentials, &size) < 0)
+    {
+        return false;
+    }
+
+    // The supplementary groups as of connect, the kernel reports how many
+    // there are if the buffer is too small. Before Linux 4.13 only the
+    // primary group is known.
+    std::vector<gid_t> groups(16);
+    auto length = static_cast<socklen_t>(groups.size() * sizeof(gid_t));
+    auto rc = getsockopt(fd, SOL_SOCKET, SO_PEERGROUPS, groups.data(),
+                         &length);
+    if (rc < 0 && errno == ERANGE)
+    {
+        groups.resize(length / sizeof(gid_t));
+        rc = getsockopt(fd, SOL_SOCKET, SO_PEERGROUPS, groups.data(),
+                        &length);
+    }
+    groups.resize(rc == 0 ? length / sizeof(gid_t) : 0);
+    groups.emplace_back(credentials.gid);
+
+    std::optional<gid_t> socketGroup;
+    struct stat info{};
+    if (stat(path.c_str(), &info) == 0)
+    {
+        socketGroup = info.st_gid;
+    }
+
+    if (isAllowed(credentials.uid, groups, socketGroup))
+    {
+        return true;
+    }
+
+    lg2::warning("Refusing peer {PID} of user {UID}", "PID", credentials.pid,
+                 "UID", credentials.uid);
+    return false;
+}
+
+void PeerServer::prune()
+{
+    for (auto connection : std::exchange(closed, {}))
+    {
+        connections.erase(connection);
+    }
+}
+
+} // namespace interface
+} // namespace sysfs
+} // namespace led
+} // namespace phosphor
@@ -0,0 +1,183 @@
+#pragma once
+
+#include "peer_interface.hpp"
+
+#include <sys/types.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace phosphor
+{
+namespace led
+{
+namespace sysfs
+{
+namespace interface
+{
+
+/** @class PeerServer
+ *  @brief Accepts direct sd-bus connections on a unix socket
+ *
+ *  Local clients changing LEDs at a high rate, e.g. activity indicators,
+ *  can connect to the socket instead of the bus and skip the broker. The
+ *  peer credentials are checked on accept: root, the user of the
+ *  controller and members of the group owning the socket, supplementary
+ *  members included, are let in. Each connection is served by its own
+ *  PeerInterface.
+ */
+class PeerServer
+{
+  public:
+    PeerServer() = delete;
+    PeerServer(const PeerServer&) = delete;
+    PeerServer& operator=(const PeerServer&) = delete;
+    PeerServer(PeerServer&&) = delete;
+    PeerServer& operator=(PeerServer&&) = delete;
+
+    /**
+     *  @brief Listens on the socket, logs and stays idle if it can not.
+     *
+     *  @param[in] event    - event loop to serve the peers on.
+     *  @param[in] path     - path of the socket.
+     *  @param[in] internal - the controller.
+     */
+
+    PeerServer(const sdeventplus::Event& event, std::filesystem::path path,
+               InternalInterface& internal);
+
+    ~PeerServer();
+
+    /**
+     *  @brief Whether a peer may connect.
+     *
+     *  @param[in] uid         - user of the peer.
+     *  @param[in] groups      - primary and supplementary groups of the
+     *                           peer.
+     *  @param[in] socketGroup - group owning the socket, nullopt if
+     *                           unknown.
+     */
+
+    static bool isAllowed(uid_t uid, const std::vector<gid_t>& groups,
+                          std::optional<gid_t> socketGroup);
+
+    /**
+     *  @brief Starts the server end of a peer connection.
+     *
+     *  @param[in] fd - the connected socket, owned by the bus from now on.
+     *
+     *  @return the connection, not attached to an event loop.
+     */
+
+    static sdbusplus::bus_t openPeer(int fd);
+
+  private:
+    /** @brief One peer and the objects served to it */
+    struct Connection
+    {
+        Connection(sdbusplus::bus_t&& bus, InternalInterface& internal,
+                   std::function<void()> onClose);
+
+        sdbusplus::bus_t bus;
+        PeerInterface objects;
+        sdbusplus::bus::match_t disconnected;
+    };
+
+    /**
+     *  @brief Event loop the peers are served on.
+     */
+
+    sdeventplus::Event event;
+
+    /**
+     *  @brief Path of the socket.
+     */
+
+    std::filesystem::path path;
+
+    /**
+     *  @brief The controller.
+     */
+
+    InternalInterface& internal;
+
+    /**
+     *  @brief The listening socket, -1 if listening failed.
+     */
+
+    int listenFd = -1;
+
+    /**
+     *  @brief Accepts the peers on the event loop.
+     */
+
+    std::optional<sdeventplus::source::IO> listener;
+
+    /**
+     *  @brief The connected peers by id.
+     */
+
+    std::map<uint64_t, std::unique_ptr<Connection>> connections;
+
+    /**
+     *  @brief Source of the connection ids.
+     */
+
+    uint64_t nextId = 0;
+
+    /**
+     *  @brief Peers that disconnected, dropped after their callbacks.
+     */
+
+    std::vector<uint64_t> closed;
+
+    /**
+     *  @brief Timer dropping the disconnected peers.
+     */
+
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> reaper;
+
+    /**
+     *  @brief Accepts all pending peers.
+     */
+
+    void accept();
+
+    /**
+     *  @brief Serves the controller on an accepted socket.
+     *
+     *  @param[in] fd - the socket, owned by the connection from now on.
+     */
+
+    void connect(int fd);
+
+    /**
+     *  @brief Checks the credentials of a peer.
+     *
+     *  @param[in] fd - the socket of the peer.
+     */
+
+    bool checkPeer(int fd) const;
+
+    /**
+     *  @brief Drops the disconnected peers.
+     */
+
+    void prune();
+};
+
+} // namespace interface
+} // namespace sysfs
+} // namespace led
+} // namespace phosphor
@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "statistics_interface.hpp"
+
+#include "fallback_vtable.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <map>
+#include <string_view>
+#include <variant>
+
+namespace phosphor
+{
+namespace led
+{
+namespace sysfs
+{
+namespace interface
+{
+
+StatisticsInterface::StatisticsInterface(phosphor::led::Physical& led) :
+    led(led)
+{}
+
+sdbusplus::slot_t StatisticsInterface::serve(sdbusplus::bus_t& bus,
+                                             const char* parent,
+                                             sd_bus_object_find_t find,
+                                             void* context)
+{
+    return addFallbackVtable(bus, parent, statisticsInterface, vtable.data(),
+                             find, context);
+}
+
+void StatisticsInterface::appendProperties(sdbusplus::message_t& m) const
+{
+    m.append(std::map<std::string, std::variant<uint64_t>>{
+        {"DeferredWrites", led.getDeferredWrites()},
+        {"MergedWrites", led.getMergedWrites()},
+        {"FailedWrites", led.getFailedWrites()},
+        {"AbandonedWrites", led.getAbandonedWrites()},
+    });
+}
+
+int StatisticsInterface::getProperty(
+    sd_bus* /*bus*/, const char* /*path*/, const char* /*interface*/,
+    const char* property, sd_bus_message* reply, void* context,
+    sd_bus_error* error)
+{
+    if (reply == nullptr || context == nullptr)
+    {
+        lg2::error("Unable to get statistics property");
+        return -EINVAL;
+    }
+
+    try
+    {
+        auto* self = static_cast<StatisticsInterface*>(context);
+        auto m = sdbusplus::message_t(reply);
+        std::string_view name(property);
+
+        if (name == "DeferredWrites")
+        {
+            m.append(self->led.getDeferredWrites());
+        }
+        else if (name == "MergedWrites")
+        {
+            m.append(self->led.getMergedWrites());
+        }
+        else if (name == "FailedWrites")
+        {
+            m.append(self->led.getFailedWrites());
+        }
+        else
+        {
+            m.append(self->led.getAbandonedWrites());
+        }
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        return sd_bus_error_set(error, e.name(), e.description());
+    }
+
+    return 1;
+}
+
+const std::array<sdbusplus::vtable::vtable_t, 6> StatisticsInterface::vtable =
+    {sdbusplus::vtable::start(),
+     // State writes deferred by the rate limit of the backing device
+     sdbusplus::vtable::property("DeferredWrites", "t", getProperty,
+                                 sdbusplus::vtable::property_::none),
+     // State writes merged into a deferred one, the last State wins
+     sdbusplus::vtable::property("MergedWrites", "t", getProperty,
+                                 sdbusplus::vtable::property_::none),
+     // Attempts to write a State that failed, retries included
+     sdbusplus::vtable::property("FailedWrites", "t", getProperty,
+                                 sdbusplus::vtable::property_::none),
+     // State writes given up on, State was rolled back
+     sdbusplus::vtable::property("AbandonedWrites", "t", getProperty,
+                                 sdbusplus::vtable::property_::none),
+     sdbusplus::vtable::end()};
+
+} // namespace interface
+} // namespace sysfs
+} // namespace led
+} // namespace phosphor
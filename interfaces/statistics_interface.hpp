@@ -0,0 +1,97 @@
+#pragma once
+
+#include "physical.hpp"
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/slot.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <array>
+
+static constexpr auto statisticsInterface =
+    "xyz.openbmc_project.Led.Sysfs.Statistics";
+
+namespace phosphor
+{
+namespace led
+{
+namespace sysfs
+{
+namespace interface
+{
+
+/** @class StatisticsInterface
+ *  @brief Exposes how often writes to a LED were throttled or failed
+ *
+ *  The counters change with every throttled or failed write, they are
+ *  not announced by PropertiesChanged.
+ */
+class StatisticsInterface
+{
+  public:
+    StatisticsInterface() = delete;
+    StatisticsInterface(const StatisticsInterface&) = delete;
+    StatisticsInterface& operator=(const StatisticsInterface&) = delete;
+    StatisticsInterface(StatisticsInterface&&) = delete;
+    StatisticsInterface& operator=(StatisticsInterface&&) = delete;
+    ~StatisticsInterface() = default;
+
+    /**
+     *  @brief Construct the interface of an LED, it is served by serve().
+     *
+     *  @param[in] led - the LED.
+     */
+
+    explicit StatisticsInterface(phosphor::led::Physical& led);
+
+    /**
+     *  @brief Serves the interface of all LEDs with one registration.
+     *
+     *  @param[in] bus     - D-Bus object.
+     *  @param[in] parent  - path the LEDs are below.
+     *  @param[in] find    - resolves the interface object of an LED.
+     *  @param[in] context - passed to find.
+     *
+     *  @return the registration, the interface is served while it lives.
+     */
+
+    static sdbusplus::slot_t serve(sdbusplus::bus_t& bus, const char* parent,
+                                   sd_bus_object_find_t find, void* context);
+
+    /**
+     *  @brief Appends the properties of the interface as a{sv}.
+     *
+     *  @param[in] m - message to append to.
+     */
+
+    void appendProperties(sdbusplus::message_t& m) const;
+
+  private:
+    /**
+     *  @brief The LED.
+     */
+
+    phosphor::led::Physical& led;
+
+    /**
+     *  @brief Systemd bus callback for the properties.
+     */
+
+    static int getProperty(sd_bus* bus, const char* path,
+                           const char* interface, const char* property,
+                           sd_bus_message* reply, void* context,
+                           sd_bus_error* error);
+
+    /**
+     *  @brief Systemd vtable structure that contains all the
+     *  methods, signals, and properties of this interface with their
+     *  respective systemd attributes
+     */
+
+    static const std::array<sdbusplus::vtable::vtable_t, 6> vtable;
+};
+
+} // namespace interface
+} // namespace sysfs
+} // namespace led
+} // namespace phosphor
@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "trigger_interface.hpp"
+
+#include "fallback_vtable.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <map>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace phosphor
+{
+namespace led
+{
+namespace sysfs
+{
+namespace interface
+{
+
+TriggerInterface::TriggerInterface(sdbusplus::bus_t& bus,
+                                   const std::string& path,
+                                   phosphor::led::Physical& led) :
+    bus(bus), path(path), led(led), triggers(&led.getTriggers()),
+    trigger(led.getTrigger()), params(led.getTriggerParams())
+{
+    led.onChange([this]() { update(); });
+}
+
+sdbusplus::slot_t TriggerInterface::serve(sdbusplus::bus_t& bus,
+                                          const char* parent,
+                                          sd_bus_object_find_t find,
+                                          void* context)
+{
+    return addFallbackVtable(bus, parent, triggerInterface, vtable.data(),
+                             find, context);
+}
+
+void TriggerInterface::appendProperties(sdbusplus::message_t& m) const
+{
+    using Value = std::variant<std::string, std::vector<std::string>,
+                               phosphor::led::TriggerParams>;
+
+    m.append(std::map<std::string, Value>{
+        {"Triggers", led.getTriggers()},
+        {"Trigger", led.getTrigger()},
+        {"Parameters", led.getTriggerParams()},
+    });
+}
+
+void TriggerInterface::update()
+{
+    // Trigger lists are shared, a new list means a new address
+    if (triggers != &led.getTriggers())
+    {
+        triggers = &led.getTriggers();
+        sd_bus_emit_properties_changed(bus.get(), path.c_str(),
+                                       triggerInterface, "Triggers", nullptr);
+    }
+
+    // Physical reports every change, only trigger changes are ours
+    if (trigger == led.getTrigger() && params == led.getTriggerParams())
+    {
+        return;
+    }
+
+    trigger = led.getTrigger();
+    params = led.getTriggerParams();
+    sd_bus_emit_properties_changed(bus.get(), path.c_str(), triggerInterface,
+                                   "Trigger", "Parameters", nullptr);
+}
+
+int TriggerInterface::getProperty(sd_bus* /*bus*/, const char* /*path*/,
+                                  const char* /*interface*/,
+                                  const char* property, sd_bus_message* reply,
+                                  void* context, sd_bus_error* error)
+{
+    if (reply == nullptr || context == nullptr)
+    {
+        lg2::error("Unable to get trigger property");
+        return -EINVAL;
+    }
+
+    try
+    {
+        auto* self = static_cast<TriggerInterface*>(context);
+        auto m = sdbusplus::message_t(reply);
+        std::string_view name(property);
+
+        if (name == "Triggers")
+        {
+            m.append(self->led.getTriggers());
+        }
+        else if (name == "Trigger")
+        {
+            m.append(self->led.getTrigger());
+        }
+        else
+        {
+            m.append(self->led.getTriggerParams());
+        }
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        return sd_bus_error_set(error, e.name(), e.description());
+    }
+
+    return 1;
+}
+
+int TriggerInterface::setTriggerConfigure(sd_bus_message* msg, void* context,
+                                          sd_bus_error* error)
+{
+    if (msg == nullptr && context == nullptr)
+    {
+        lg2::error("Unable to configure setTrigger");
+        return -EINVAL;
+    }
+
+    try
+    {
+        auto message = sdbusplus::message_t(msg);
+        auto [trigger, params] =
+            message.unpack<std::string, phosphor::led::TriggerParams>();
+
+        auto* self = static_cast<TriggerInterface*>(context);
+        self->led.setTrigger(trigger, params);
+
+        auto reply = message.new_method_return();
+        reply.method_return();
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        return sd_bus_error_set(error, e.name(), e.description());
+    }
+
+    return 1;
+}
+
+const std::array<sdbusplus::vtable::vtable_t, 6> TriggerInterface::vtable = {
+    sdbusplus::vtable::start(),
+    // Triggers supported by the LED, read once the LED is bound
+    sdbusplus::vtable::property("Triggers", "as", getProperty,
+                                sdbusplus::vtable::property_::emits_change),
+    // The trigger currently driving the LED
+    sdbusplus::vtable::property("Trigger", "s", getProperty,
+                                sdbusplus::vtable::property_::emits_change),
+    // Attributes set along with the trigger
+    sdbusplus::vtable::property("Parameters", "a{ss}", getProperty,
+                                sdbusplus::vtable::property_::emits_change),
+    // SetTrigger takes the trigger and its attributes and returns void
+    sdbusplus::vtable::method("SetTrigger", "sa{ss}", "", setTriggerConfigure),
+    sdbusplus::vtable::end()};
+
+} // namespace interface
+} // namespace sysfs
+} // namespace led
+} // namespace phosphor
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "physical.hpp"
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/slot.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <array>
+#include <string>
+#include <vector>
+
+static constexpr auto triggerInterface = "xyz.openbmc_project.Led.Sysfs.Trigger";
+
+namespace phosphor
+{
+namespace led
+{
+namespace sysfs
+{
+namespace interface
+{
+
+/** @class TriggerInterface
+ *  @brief Exposes the kernel triggers of a LED
+ *
+ *  Lists the triggers the kernel supports for the LED and lets a client
+ *  hand the LED over to one of them, e.g. netdev or heartbeat. The kernel
+ *  then drives the LED without any D-Bus traffic.
+ */
+class TriggerInterface
+{
+  public:
+    TriggerInterface() = delete;
+    TriggerInterface(const TriggerInterface&) = delete;
+    TriggerInterface& operator=(const TriggerInterface&) = delete;
+    TriggerInterface(TriggerInterface&&) = delete;
+    TriggerInterface& operator=(TriggerInterface&&) = delete;
+    ~TriggerInterface() = default;
+
+    /**
+     *  @brief Construct the interface of an LED, it is served by serve().
+     *
+     *  @param[in] bus  - D-Bus object.
+     *  @param[in] path - D-Bus Path of the LED, it has to outlive the
+     *                    interface.
+     *  @param[in] led  - the LED.
+     */
+
+    TriggerInterface(sdbusplus::bus_t& bus, const std::string& path,
+                     phosphor::led::Physical& led);
+
+    /**
+     *  @brief Serves the interface of all LEDs with one registration.
+     *
+     *  @param[in] bus     - D-Bus object.
+     *  @param[in] parent  - path the LEDs are below.
+     *  @param[in] find    - resolves the interface object of an LED.
+     *  @param[in] context - passed to find.
+     *
+     *  @return the registration, the interface is served while it lives.
+     */
+
+    static sdbusplus::slot_t serve(sdbusplus::bus_t& bus, const char* parent,
+                                   sd_bus_object_find_t find, void* context);
+
+    /**
+     *  @brief Appends the properties of the interface as a{sv}.
+     *
+     *  @param[in] m - message to append to.
+     */
+
+    void appendProperties(sdbusplus::message_t& m) const;
+
+  private:
+    /**
+     *  @brief D-Bus object sending the PropertiesChanged signals.
+     */
+
+    sdbusplus::bus_t& bus;
+
+    /**
+     *  @brief D-Bus Path of the LED.
+     */
+
+    const std::string& path;
+
+    /**
+     *  @brief The LED.
+     */
+
+    phosphor::led::Physical& led;
+
+    /**
+     *  @brief Triggers last announced, they only change once a
+     *  configured LED is bound.
+     */
+
+    const std::vector<std::string>* triggers;
+
+    /**
+     *  @brief Trigger last announced by a PropertiesChanged signal.
+     */
+
+    std::string trigger;
+
+    /**
+     *  @brief Attributes last announced by a PropertiesChanged signal.
+     */
+
+    phosphor::led::TriggerParams params;
+
+    /**
+     *  @brief Emits PropertiesChanged if the triggers, the trigger or its
+     *  attributes changed.
+     */
+
+    void update();
+
+    /**
+     *  @brief Systemd bus callback for the properties.
+     */
+
+    static int getProperty(sd_bus* bus, const char* path,
+                           const char* interface, const char* property,
+                           sd_bus_message* reply, void* context,
+                           sd_bus_error* error);
+
+    /**
+     *  @brief Systemd bus callback for the SetTrigger method.
+     */
+
+    static int setTriggerConfigure(sd_bus_message* msg, void* context,
+                                   sd_bus_error* error);
+
+    /**
+     *  @brief Systemd vtable structure that contains all the
+     *  methods, signals, and properties of this interface with their
+     *  respective systemd attributes
+     */
+
+    static const std::array<sdbusplus::vtable::vtable_t, 6> vtable;
+};
+
+} // namespace interface
+} // namespace sysfs
+} // namespace led
+} // namespace phosphor
@@ -0,0 +1,201 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "lag_monitor.hpp"
+
+#include <systemd/sd-daemon.h>
+#include <systemd/sd-event.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <ranges>
+
+namespace phosphor
+{
+namespace led
+{
+
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+LagMonitor::LagMonitor(const sdeventplus::Event& event) :
+    event(event), clock(event),
+    probe(event, clock.now() + probeInterval, microseconds(1000),
+          [this](auto&, auto scheduled) { tick(scheduled); })
+{
+    // Only set when started by systemd with WatchdogSec
+    uint64_t usec = 0;
+    if (sd_watchdog_enabled(0, &usec) > 0)
+    {
+        watchdog = microseconds(usec);
+    }
+}
+
+void LagMonitor::add(const void* owner, std::string_view name)
+{
+    names.insert_or_assign(owner, name);
+}
+
+void LagMonitor::remove(const void* owner)
+{
+    names.erase(owner);
+}
+
+void LagMonitor::record(const void* owner, microseconds duration)
+{
+    writeHistogram[getBucket(duration)]++;
+    touch(owner);
+
+    auto it = names.find(owner);
+    if (it == names.end())
+    {
+        return;
+    }
+
+    // Every slow write is logged, listed or not
+    if (duration >= slowWrite)
+    {
+        lg2::warning("Writing LED {NAME} blocked the loop for {DURATION}us",
+                     "NAME", it->second, "DURATION", duration.count());
+    }
+
+    // Each LED is listed once, with its slowest write
+    auto offender = std::ranges::find(offenders, it->second, &Offender::name);
+    if (offender != offenders.end())
+    {
+        if (duration <= offender->duration)
+        {
+            return;
+        }
+        offenders.erase(offender);
+    }
+    else if (offenders.size() == offenderCount &&
+             duration <= offenders.back().duration)
+    {
+        return;
+    }
+
+    auto pos = std::ranges::upper_bound(offenders, duration, std::greater<>{},
+                                        &Offender::duration);
+    offenders.emplace(pos, std::string(it->second), duration);
+    if (offenders.size() > offenderCount)
+    {
+        offenders.pop_back();
+    }
+}
+
+void LagMonitor::touch(const void* owner)
+{
+    auto it = names.find(owner);
+    if (!dispatching || it == names.end() ||
+        std::ranges::find(touched, it->second) != touched.end())
+    {
+        return;
+    }
+
+    touched.emplace_back(it->second);
+}
+
+int LagMonitor::loop()
+{
+    auto* loop = event.get();
+    while (sd_event_get_state(loop) != SD_EVENT_FINISHED)
+    {
+        // sd_event_run() taken apart, so only the dispatch is timed and
+        // not the wait for events
+        auto rc = sd_event_prepare(loop);
+        if (rc == 0)
+        {
+            rc = sd_event_wait(loop, UINT64_MAX);
+        }
+        if (rc > 0)
+        {
+            dispatching = true;
+            touched.clear();
+            auto start = std::chrono::steady_clock::now();
+            rc = sd_event_dispatch(loop);
+            dispatching = false;
+            dispatched(duration_cast<microseconds>(
+                std::chrono::steady_clock::now() - start));
+        }
+        if (rc < 0)
+        {
+            return rc;
+        }
+    }
+
+    int code = 0;
+    auto rc = sd_event_get_exit_code(loop, &code);
+    return rc < 0 ? rc : code;
+}
+
+void LagMonitor::dispatched(microseconds duration)
+{
+    dispatchHistogram[getBucket(duration)]++;
+    maxDispatch = std::max(maxDispatch, duration);
+
+    if (duration < slowWrite)
+    {
+        return;
+    }
+
+    // A batch may write many LEDs, the first few tell where it came from
+    std::string leds;
+    for (auto name : touched | std::views::take(offenderCount))
+    {
+        leds += (leds.empty() ? "" : ", ") + std::string(name);
+    }
+    lg2::warning("Dispatching an event blocked the loop for {DURATION}us, "
+                 "{COUNT} LEDs written: {LEDS}",
+                 "DURATION", duration.count(), "COUNT", touched.size(),
+                 "LEDS", leds);
+}
+
+void LagMonitor::tick(Clock::time_point scheduled)
+{
+    auto now = clock.now();
+    auto lag = duration_cast<microseconds>(now - scheduled);
+
+    lagHistogram[getBucket(lag)]++;
+    maxLag = std::max(maxLag, lag);
+
+    if (lag < lagThreshold)
+    {
+        stalled = false;
+
+        // Well within the timeout, systemd asks for half of it at least
+        if (watchdog && now - lastPing >= *watchdog / 4)
+        {
+            sd_notify(0, "WATCHDOG=1");
+            lastPing = now;
+        }
+    }
+    else if (!stalled)
+    {
+        stalled = true;
+        lg2::error("LED controller loop ran {LAG}us late", "LAG",
+                   lag.count());
+        for (const auto& offender : offenders)
+        {
+            lg2::error("Writing LED {NAME} took up to {DURATION}us", "NAME",
+                       offender.name, "DURATION", offender.duration.count());
+        }
+    }
+
+    probe.set_time(now + probeInterval);
+    probe.set_enabled(sdeventplus::source::Enabled::OneShot);
+}
+
+size_t LagMonitor::getBucket(microseconds duration)
+{
+    auto ms = static_cast<uint64_t>(
+        std::max<int64_t>(duration_cast<milliseconds>(duration).count(), 0));
+    return std::min<size_t>(std::bit_width(ms), Histogram{}.size() - 1);
+}
+
+} // namespace led
+} // namespace phosphor
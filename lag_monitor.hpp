@@ -0,0 +1,201 @@
+#pragma once
+
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/time.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace phosphor
+{
+namespace led
+{
+
+/** @class LagMonitor
+ *  @brief Measures how late the event loop runs and how long its handlers
+ *   and LED writes block it
+ *
+ *  A probe timer expires every probeInterval, the time between its
+ *  scheduled and actual expiry is the dispatch lag of the loop. Run by
+ *  loop(), the duration of every dispatch is measured, whatever handler
+ *  it runs: bus calls, timers, queued writes and their completions alike.
+ *  State writes made directly report their duration per LED. All go into
+ *  histograms of power of two milliseconds, the LEDs with the slowest
+ *  writes are kept by name. The systemd watchdog is only pinged while the
+ *  lag stays below lagThreshold, so a loop stalled for WatchdogSec is
+ *  restarted.
+ */
+class LagMonitor
+{
+  public:
+    LagMonitor() = delete;
+    ~LagMonitor() = default;
+    LagMonitor(const LagMonitor&) = delete;
+    LagMonitor& operator=(const LagMonitor&) = delete;
+    LagMonitor(LagMonitor&&) = delete;
+    LagMonitor& operator=(LagMonitor&&) = delete;
+
+    /** @brief Counts by bucket, bucket 0 holds durations below 1ms and
+     *   bucket n those from 2^(n-1)ms, the last one everything above
+     */
+    using Histogram = std::array<uint64_t, 12>;
+
+    /** @brief Slowest write of an LED */
+    struct Offender
+    {
+        std::string name;
+        std::chrono::microseconds duration;
+    };
+
+    /** @brief Constructs the monitor and starts probing
+     *
+     *  @param[in] event - event loop to monitor
+     */
+    explicit LagMonitor(const sdeventplus::Event& event);
+
+    /** @brief Names an LED for the offender list
+     *
+     *  @param[in] owner - identifies the LED
+     *  @param[in] name  - name of the LED, has to outlive the LED
+     */
+    void add(const void* owner, std::string_view name);
+
+    /** @brief Forgets an LED, it stays in the offender list by name
+     *
+     *  @param[in] owner - identifies the LED
+     */
+    void remove(const void* owner);
+
+    /** @brief Records the duration of a write
+     *
+     *  @param[in] owner    - identifies the LED
+     *  @param[in] duration - time the write blocked the loop
+     */
+    void record(const void* owner, std::chrono::microseconds duration);
+
+    /** @brief Notes an LED written by the running dispatch, a slow one is
+     *   logged with the LEDs it wrote
+     *
+     *  @param[in] owner - identifies the LED
+     */
+    void touch(const void* owner);
+
+    /** @brief Runs the event loop like sd_event_loop(), timing each
+     *   dispatch
+     *
+     *  @return the exit code of the loop, or -errno if it failed
+     */
+    int loop();
+
+    /** @brief Dispatch lag of the loop */
+    const Histogram& getLagHistogram() const
+    {
+        return lagHistogram;
+    }
+
+    /** @brief Duration of the writes */
+    const Histogram& getWriteHistogram() const
+    {
+        return writeHistogram;
+    }
+
+    /** @brief Duration of the dispatches */
+    const Histogram& getDispatchHistogram() const
+    {
+        return dispatchHistogram;
+    }
+
+    /** @brief Largest dispatch lag seen */
+    std::chrono::microseconds getMaxLag() const
+    {
+        return maxLag;
+    }
+
+    /** @brief Longest dispatch seen */
+    std::chrono::microseconds getMaxDispatch() const
+    {
+        return maxDispatch;
+    }
+
+    /** @brief LEDs with the slowest writes, slowest first */
+    const std::vector<Offender>& getOffenders() const
+    {
+        return offenders;
+    }
+
+    /** @brief Interval of the probe timer */
+    static constexpr std::chrono::milliseconds probeInterval{100};
+
+    /** @brief Lag up to which the watchdog is pinged */
+    static constexpr std::chrono::milliseconds lagThreshold{500};
+
+    /** @brief Writes and dispatches taking longer are logged */
+    static constexpr std::chrono::milliseconds slowWrite{50};
+
+    /** @brief Number of LEDs kept in the offender list */
+    static constexpr size_t offenderCount = 5;
+
+  private:
+    using Clock = sdeventplus::Clock<sdeventplus::ClockId::Monotonic>;
+
+    /** @brief The monitored loop */
+    sdeventplus::Event event;
+
+    /** @brief Clock of the event loop */
+    Clock clock;
+
+    /** @brief Probe timer */
+    sdeventplus::source::Time<sdeventplus::ClockId::Monotonic> probe;
+
+    /** @brief Watchdog timeout set by systemd, nullopt without one */
+    std::optional<Clock::duration> watchdog;
+
+    /** @brief When the watchdog was pinged last */
+    Clock::time_point lastPing;
+
+    Histogram lagHistogram{};
+    Histogram writeHistogram{};
+    Histogram dispatchHistogram{};
+    std::chrono::microseconds maxLag{};
+    std::chrono::microseconds maxDispatch{};
+
+    /** @brief Names of the LEDs */
+    std::map<const void*, std::string_view> names;
+
+    /** @brief LEDs with the slowest writes, slowest first */
+    std::vector<Offender> offenders;
+
+    /** @brief loop() runs a dispatch */
+    bool dispatching = false;
+
+    /** @brief Names of the LEDs the running dispatch wrote */
+    std::vector<std::string_view> touched;
+
+    /** @brief The lag is above lagThreshold */
+    bool stalled = false;
+
+    /** @brief Records the lag of a probe and pings the watchdog
+     *
+     *  @param[in] scheduled - when the probe should have expired
+     */
+    void tick(Clock::time_point scheduled);
+
+    /** @brief Records the duration of a dispatch
+     *
+     *  @param[in] duration - time the dispatch blocked the loop
+     */
+    void dispatched(std::chrono::microseconds duration);
+
+    /** @brief Bucket of a duration */
+    static size_t getBucket(std::chrono::microseconds duration);
+};
+
+} // namespace led
+} // namespace phosphor
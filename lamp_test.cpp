@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "lamp_test.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/exception.hpp>
+
+#include <filesystem>
+#include <map>
+#include <string>
+
+namespace phosphor
+{
+namespace led
+{
+
+LampTest::LampTest(const sdeventplus::Event& event) :
+    timer(event, [this](auto&) { stop(); })
+{
+    timer.setEnabled(false);
+}
+
+std::chrono::microseconds LampTest::start(const std::vector<Physical*>& leds,
+                                          std::chrono::milliseconds duration)
+{
+    if (!active)
+    {
+        snapshots.clear();
+        snapshots.reserve(leds.size());
+        for (auto* led : leds)
+        {
+            // A pattern or fade of the sequencers could not be restored
+            if (led->isPlaying())
+            {
+                lg2::info("Lamp test skips an LED playing a pattern");
+                continue;
+            }
+
+            snapshots.emplace_back(led, led->state(), led->period(),
+                                   led->dutyOn(), led->getTrigger(),
+                                   led->getTriggerParams());
+        }
+        active = true;
+    }
+
+    std::vector<Physical*> tested;
+    tested.reserve(snapshots.size());
+    for (const auto& snapshot : snapshots)
+    {
+        tested.emplace_back(snapshot.led);
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    {
+        WriteQueue::Batch batch(writeQueue);
+        for (auto* led : fanOut(tested))
+        {
+            led->setState(Action::On);
+        }
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - begin);
+
+    timer.restartOnce(duration);
+
+    lg2::info("Lamp test of {COUNT} LEDs applied in {ELAPSED} us", "COUNT",
+              tested.size(), "ELAPSED", elapsed.count());
+
+    return elapsed;
+}
+
+bool LampTest::stop()
+{
+    if (!active)
+    {
+        return false;
+    }
+
+    active = false;
+    timer.setEnabled(false);
+
+    WriteQueue::Batch batch(writeQueue);
+
+    for (const auto& snapshot : snapshots)
+    {
+        auto* led = snapshot.led;
+        if (led->state() != Action::On)
+        {
+            continue;
+        }
+
+        // Period and DutyOn first, so a blink starts with them
+        if (led->period() != snapshot.period)
+        {
+            led->period(snapshot.period);
+        }
+        if (led->dutyOn() != snapshot.dutyOn)
+        {
+            led->dutyOn(snapshot.dutyOn);
+        }
+        led->setState(snapshot.state);
+
+        // State alone does not bring back a kernel trigger or pattern
+        if (snapshot.trigger != "none" && snapshot.trigger != "timer")
+        {
+            try
+            {
+                led->setTrigger(snapshot.trigger, snapshot.params);
+            }
+            catch (const sdbusplus::exception_t& e)
+            {
+                lg2::error("Unable to restore trigger {TRIGGER}: {ERROR}",
+                           "TRIGGER", snapshot.trigger, "ERROR", e.what());
+            }
+        }
+    }
+    snapshots.clear();
+
+    lg2::info("Lamp test ended");
+
+    return true;
+}
+
+std::vector<Physical*> LampTest::fanOut(const std::vector<Physical*>& leds)
+{
+    std::map<std::filesystem::path, std::vector<Physical*>> devices;
+    for (auto* led : leds)
+    {
+        devices[led->getDevice()].emplace_back(led);
+    }
+
+    std::vector<Physical*> ordered;
+    ordered.reserve(leds.size());
+    for (size_t i = 0; ordered.size() < leds.size(); ++i)
+    {
+        for (const auto& [device, members] : devices)
+        {
+            if (i < members.size())
+            {
+                ordered.emplace_back(members[i]);
+            }
+        }
+    }
+
+    return ordered;
+}
+
+} // namespace led
+} // namespace phosphor
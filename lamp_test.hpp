@@ -0,0 +1,120 @@
+#pragma once
+
+#include "physical.hpp"
+#include "write_queue.hpp"
+
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace phosphor
+{
+namespace led
+{
+
+/** @class LampTest
+ *  @brief Turns all LEDs on for a while and restores them afterwards
+ *
+ *  The State, Period, DutyOn and kernel trigger of every LED are kept in
+ *  memory when the test starts. When it ends, by its timer or by stop(),
+ *  each LED still on is set back to them. An LED set to another State
+ *  during the test keeps it. LEDs playing a pattern or fade in software
+ *  are left out, what they play could not be restored. The test overrides
+ *  the State requested through the arbiter.
+ */
+class LampTest
+{
+  public:
+    LampTest() = delete;
+    ~LampTest() = default;
+    LampTest(const LampTest&) = delete;
+    LampTest& operator=(const LampTest&) = delete;
+    LampTest(LampTest&&) = delete;
+    LampTest& operator=(LampTest&&) = delete;
+
+    using Action =
+        sdbusplus::xyz::openbmc_project::Led::server::Physical::Action;
+
+    /** @brief Constructs the lamp test
+     *
+     *  @param[in] event - event loop to run the timer on
+     */
+    explicit LampTest(const sdeventplus::Event& event);
+
+    /** @brief Turns the LEDs on until the duration passed
+     *
+     *  Starting a running test only extends it, the LEDs keep the State
+     *  they had before the first start.
+     *
+     *  @param[in] leds     - the LEDs
+     *  @param[in] duration - time the LEDs stay on
+     *  @return the time it took to turn the LEDs on, or to submit the
+     *   writes when they are queued
+     */
+    std::chrono::microseconds start(const std::vector<Physical*>& leds,
+                                    std::chrono::milliseconds duration);
+
+    /** @brief Ends the test and restores the LEDs
+     *
+     *  @return false if no test was running
+     */
+    bool stop();
+
+    /** @brief Sets the queue the writes of all LEDs are batched in
+     *
+     *  @param[in] queue - the queue shared by all LEDs
+     */
+    void setWriteQueue(WriteQueue* queue)
+    {
+        writeQueue = queue;
+    }
+
+    /** @brief Whether a test is running */
+    bool isActive() const
+    {
+        return active;
+    }
+
+  private:
+    /** @brief Properties of an LED before the test */
+    struct Snapshot
+    {
+        Physical* led;
+        Action state;
+        uint16_t period;
+        uint8_t dutyOn;
+
+        /** @brief Trigger, e.g. one set by SetTrigger or a pattern */
+        std::string trigger;
+        TriggerParams params;
+    };
+
+    /** @brief Timer ending the test */
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> timer;
+
+    /** @brief The LEDs as they were before the test */
+    std::vector<Snapshot> snapshots;
+
+    /** @brief Whether a test is running */
+    bool active = false;
+
+    /** @brief Queue batching the writes of all LEDs */
+    WriteQueue* writeQueue = nullptr;
+
+    /** @brief Orders the LEDs round robin across their devices
+     *
+     *  Each device gets its first LED written before any device its
+     *  second, so every device lights up early even if one is slow.
+     *
+     *  @param[in] leds - the LEDs
+     */
+    static std::vector<Physical*> fanOut(const std::vector<Physical*>& leds);
+};
+
+} // namespace led
+} // namespace phosphor
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "sysfs.hpp"
+#include "write_queue.hpp"
+
+#include <concepts>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phosphor
+{
+namespace led
+{
+
+/** @brief The LED writes a State change is made of */
+template <typename T>
+concept LedBackend =
+    requires(T& led, const std::string& name, unsigned long value) {
+        { led.setBrightness(value) } -> std::same_as<int>;
+        { led.setTrigger(name) } -> std::same_as<int>;
+        { led.setTriggerAttr(name, name) } -> std::same_as<int>;
+        { led.setDelayOn(value) } -> std::same_as<int>;
+        { led.setDelayOff(value) } -> std::same_as<int>;
+    };
+
+static_assert(LedBackend<SysfsLed>);
+
+/** @class QueuedSysfsLed
+ *  @brief Collects the sysfs writes of SysfsLed for a WriteQueue
+ *
+ *  The writes are only recorded, they all succeed here and report their
+ *  result once the queue completed them.
+ */
+class QueuedSysfsLed
+{
+  public:
+    explicit QueuedSysfsLed(SysfsLed& led) : led(led) {}
+
+    int setBrightness(unsigned long value)
+    {
+        // The kernel drops the trigger when the LED is turned off
+        if (value == 0)
+        {
+            led.invalidateTrigger();
+        }
+        return add(SysfsLed::attrBrightness, std::to_string(value));
+    }
+
+    int setTrigger(const std::string& trigger)
+    {
+        led.invalidateTrigger();
+        return add(SysfsLed::attrTrigger, trigger);
+    }
+
+    int setTriggerAttr(const std::string& attr, const std::string& value)
+    {
+        return add(attr.c_str(), value);
+    }
+
+    int setDelayOn(unsigned long ms)
+    {
+        return add(SysfsLed::attrDelayOn, std::to_string(ms));
+    }
+
+    int setDelayOff(unsigned long ms)
+    {
+        return add(SysfsLed::attrDelayOff, std::to_string(ms));
+    }
+
+    /** @brief Hands over the recorded writes */
+    std::vector<WriteQueue::Write> take()
+    {
+        return std::move(writes);
+    }
+
+  private:
+    SysfsLed& led;
+    std::vector<WriteQueue::Write> writes;
+
+    int add(const char* attr, std::string value)
+    {
+        writes.emplace_back((led.root / attr).string(), std::move(value));
+        return 0;
+    }
+};
+
+static_assert(LedBackend<QueuedSysfsLed>);
+
+/** @brief Writes a steady brightness
+ *
+ *  @param[in] led        - the backend
+ *  @param[in] brightness - the brightness
+ *  @return 0 or the -errno of the first failed write
+ */
+template <LedBackend Backend>
+int writeSteady(Backend& led, unsigned long brightness)
+{
+    auto rc = led.setTrigger("none");
+    if (rc == 0)
+    {
+        rc = led.setBrightness(brightness);
+    }
+
+    return rc;
+}
+
+/** @brief Starts the timer trigger
+ *
+ *  The trigger has to be selected before its attributes appear.
+ *
+ *  @param[in] led        - the backend
+ *  @param[in] delayOn    - milliseconds on
+ *  @param[in] delayOff   - milliseconds off
+ *  @param[in] brightness - brightness to blink with, if it has to be set
+ *  @return 0 or the -errno of the first failed write
+ */
+template <LedBackend Backend>
+int writeBlink(Backend& led, unsigned long delayOn, unsigned long delayOff,
+               std::optional<unsigned long> brightness)
+{
+    auto rc = led.setTrigger("timer");
+    if (rc == 0)
+    {
+        rc = led.setDelayOn(delayOn);
+    }
+    if (rc == 0)
+    {
+        rc = led.setDelayOff(delayOff);
+    }
+    if (rc == 0 && brightness)
+    {
+        rc = led.setBrightness(*brightness);
+    }
+
+    return rc;
+}
+
+} // namespace led
+} // namespace phosphor
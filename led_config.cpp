@@ -0,0 +1,201 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "led_config.hpp"
+
+#include "sysfs.hpp"
+
+#include <nlohmann/json.hpp>
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <set>
+#include <stdexcept>
+
+namespace phosphor
+{
+namespace led
+{
+
+namespace
+{
+
+using Action = LedConfig::Action;
+
+constexpr std::array<std::pair<std::string_view, Action>, 3> states = {{
+    {"On", Action::On},
+    {"Off", Action::Off},
+    {"Blink", Action::Blink},
+}};
+
+/** @brief Whether a name may be used as object path element */
+bool isValidName(std::string_view name)
+{
+    return !name.empty() && std::ranges::all_of(name, [](char c) {
+        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
+               (c >= '0' && c <= '9') || c == '_';
+    });
+}
+
+} // namespace
+
+LedConfig LedConfig::parse(std::string_view json)
+{
+    auto root = nlohmann::json::parse(json, nullptr, false);
+    if (root.is_discarded() || !root.is_object())
+    {
+        throw std::invalid_argument("not a JSON object");
+    }
+
+    LedConfig config;
+    std::set<std::string, std::less<>> names;
+
+    try
+    {
+        for (const auto& led : root.value("leds", nlohmann::json::array()))
+        {
+            auto sysfsName = led.at("sysfs").get<std::string>();
+
+            Entry entry;
+            entry.name = led.at("name").get<std::string>();
+            if (!isValidName(entry.name))
+            {
+                throw std::invalid_argument("invalid name " + entry.name);
+            }
+            if (!names.insert(entry.name).second)
+            {
+                throw std::invalid_argument("duplicate name " + entry.name);
+            }
+
+            entry.color = led.value(
+                "color", std::string(parseLedName(sysfsName).color));
+
+            if (led.contains("state"))
+            {
+                auto state = led.at("state").get<std::string>();
+                auto it = std::ranges::find(
+                    states, state, &decltype(states)::value_type::first);
+                if (it == states.end())
+                {
+                    throw std::invalid_argument("invalid state " + state);
+                }
+                entry.state = it->second;
+            }
+
+            auto index = config.entries.size();
+            config.bySysfsName.emplace_back(std::move(sysfsName), index);
+            auto aliases = led.value("aliases", nlohmann::json::array());
+            for (const auto& alias : aliases)
+            {
+                config.bySysfsName.emplace_back(alias.get<std::string>(),
+                                                index);
+            }
+
+            config.entries.emplace_back(std::move(entry));
+        }
+
+        for (const auto& item : root.value("groups", nlohmann::json::array()))
+        {
+            Group group;
+            group.name = item.at("name").get<std::string>();
+            if (!isValidName(group.name))
+            {
+                throw std::invalid_argument("invalid name " + group.name);
+            }
+
+            group.members =
+                item.at("members").get<std::vector<std::string>>();
+            if (group.members.empty())
+            {
+                throw std::invalid_argument("empty group " + group.name);
+            }
+            for (const auto& member : group.members)
+            {
+                if (!names.contains(member))
+                {
+                    throw std::invalid_argument("unknown member " + member);
+                }
+            }
+
+            config.groups.emplace_back(std::move(group));
+        }
+
+        if (root.contains("rateLimit"))
+        {
+            const auto& limit = root.at("rateLimit");
+            config.rateLimit.rate = limit.value("rate", config.rateLimit.rate);
+            config.rateLimit.burst =
+                limit.value("burst", config.rateLimit.burst);
+        }
+
+        // Groups share the namespace of the LEDs
+        for (const auto& group : config.groups)
+        {
+            if (!names.insert(group.name).second)
+            {
+                throw std::invalid_argument("duplicate name " + group.name);
+            }
+        }
+    }
+    catch (const nlohmann::json::exception& e)
+    {
+        throw std::invalid_argument(e.what());
+    }
+
+    std::ranges::sort(config.bySysfsName);
+    auto duplicate = std::ranges::adjacent_find(
+        config.bySysfsName, {}, &decltype(bySysfsName)::value_type::first);
+    if (duplicate != config.bySysfsName.end())
+    {
+        throw std::invalid_argument("duplicate sysfs name " + duplicate->first);
+    }
+
+    return config;
+}
+
+LedConfig LedConfig::load(const std::filesystem::path& path)
+{
+    // The configuration is optional
+    std::ifstream file(path);
+    if (!file)
+    {
+        return {};
+    }
+
+    std::string json{std::istreambuf_iterator<char>(file),
+                     std::istreambuf_iterator<char>()};
+
+    try
+    {
+        auto config = parse(json);
+        lg2::info("Configured {COUNT} LEDs from {PATH}", "COUNT",
+                  config.entries.size(), "PATH", path.string());
+        return config;
+    }
+    catch (const std::invalid_argument& e)
+    {
+        lg2::error("Ignoring LED configuration {PATH}: {ERROR}", "PATH",
+                   path.string(), "ERROR", e.what());
+        return {};
+    }
+}
+
+auto LedConfig::find(std::string_view sysfsName) const -> const Entry*
+{
+    auto it = std::ranges::lower_bound(
+        bySysfsName, sysfsName, std::less<>{},
+        &decltype(bySysfsName)::value_type::first);
+    if (it == bySysfsName.end() || it->first != sysfsName)
+    {
+        return nullptr;
+    }
+
+    return &entries[it->second];
+}
+
+} // namespace led
+} // namespace phosphor
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <xyz/openbmc_project/Led/Physical/server.hpp>
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+static constexpr auto defaultConfigPath =
+    "/usr/share/phosphor-led-sysfs/leds.json";
+
+namespace phosphor
+{
+namespace led
+{
+
+/** @class LedConfig
+ *  @brief LEDs known before the kernel enumerates them
+ *
+ *  The optional configuration lists the LEDs of a system by sysfs name,
+ *  each with the object path leaf, color, State and alternate sysfs names.
+ *  Groups of configured LEDs get an object of their own. The configuration
+ *  is parsed once at startup, sysfs names and aliases are then resolved
+ *  through a sorted table. The rate of State writes per backing device
+ *  is limited to protect other users of a shared bus.
+ *
+ *  @code
+ *  {
+ *      "leds": [
+ *          {
+ *              "sysfs": "platform:blue:identify",
+ *              "aliases": ["identify"],
+ *              "name": "identify",
+ *              "color": "blue",
+ *              "state": "Off"
+ *          }
+ *      ],
+ *      "groups": [
+ *          {
+ *              "name": "identify_all",
+ *              "members": ["identify", "rear_identify"]
+ *          }
+ *      ],
+ *      "rateLimit": {"rate": 50, "burst": 10}
+ *  }
+ *  @endcode
+ */
+class LedConfig
+{
+  public:
+    using Action =
+        sdbusplus::xyz::openbmc_project::Led::server::Physical::Action;
+
+    /** @brief One configured LED */
+    struct Entry
+    {
+        /** @brief Leaf of the object path */
+        std::string name;
+
+        /** @brief led color name, defaults to the color in the sysfs name */
+        std::string color;
+
+        /** @brief State applied once the LED appears, nullopt keeps what
+         *   the LED shows
+         */
+        std::optional<Action> state;
+    };
+
+    /** @brief LEDs set together through one object */
+    struct Group
+    {
+        /** @brief Leaf of the object path */
+        std::string name;
+
+        /** @brief Names of the member LEDs, all of them configured */
+        std::vector<std::string> members;
+    };
+
+    /** @brief Limit of the State writes to one backing device */
+    struct RateLimit
+    {
+        /** @brief Writes per second, 0 for no limit */
+        unsigned rate = 0;
+
+        /** @brief Writes passing at once */
+        unsigned burst = 10;
+    };
+
+    /** @brief Parses a JSON configuration
+     *
+     *  @param[in] json - the configuration
+     *  @return the configuration
+     *  @throws std::invalid_argument if the configuration is malformed
+     */
+    static LedConfig parse(std::string_view json);
+
+    /** @brief Loads the configuration file
+     *
+     *  @param[in] path - path of the configuration
+     *  @return the configuration, empty if the file is absent or invalid
+     */
+    static LedConfig load(const std::filesystem::path& path);
+
+    /** @brief The configured LEDs */
+    const std::vector<Entry>& getEntries() const
+    {
+        return entries;
+    }
+
+    /** @brief The configured groups */
+    const std::vector<Group>& getGroups() const
+    {
+        return groups;
+    }
+
+    /** @brief The limit of writes per backing device */
+    const RateLimit& getRateLimit() const
+    {
+        return rateLimit;
+    }
+
+    /** @brief Finds the LED of a sysfs name or alias
+     *
+     *  @param[in] sysfsName - LED name, the directory name in sysfs
+     *  @return the LED, nullptr if it is not configured
+     */
+    const Entry* find(std::string_view sysfsName) const;
+
+  private:
+    /** @brief The configured LEDs */
+    std::vector<Entry> entries;
+
+    /** @brief The configured groups */
+    std::vector<Group> groups;
+
+    /** @brief The limit of writes per backing device */
+    RateLimit rateLimit;
+
+    /** @brief Index into entries by sysfs name and alias, sorted */
+    std::vector<std::pair<std::string, size_t>> bySysfsName;
+};
+
+} // namespace led
+} // namespace phosphor
@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "logical.hpp"
+
+#include <algorithm>
+#include <ranges>
+#include <utility>
+
+namespace phosphor
+{
+namespace led
+{
+
+Logical::Logical(sdbusplus::bus_t& bus, const std::string& objPath,
+                 std::vector<phosphor::led::Physical*> members,
+                 bool deferSignals) :
+    PhysicalIfaces(bus, objPath.c_str(), PhysicalIfaces::action::defer_emit),
+    members(std::move(members))
+{
+    for (auto* member : this->members)
+    {
+        member->onChange([this]() {
+            if (!dispatching)
+            {
+                update();
+            }
+        });
+    }
+
+    if (!this->members.empty())
+    {
+        auto* first = this->members.front();
+        sdbusplus::xyz::openbmc_project::Led::server::Physical::dutyOn(
+            first->dutyOn());
+        sdbusplus::xyz::openbmc_project::Led::server::Physical::period(
+            first->period());
+    }
+    update();
+
+    if (!deferSignals)
+    {
+        emit_object_added();
+    }
+}
+
+auto Logical::state() const -> Action
+{
+    return sdbusplus::xyz::openbmc_project::Led::server::Physical::state();
+}
+
+auto Logical::state(Action value) -> Action
+{
+    group();
+
+    dispatching = true;
+    {
+        // The members are submitted together once all are queued
+        WriteQueue::Batch batch(writeQueue);
+        for (auto* member : members)
+        {
+            member->state(value);
+        }
+    }
+
+    // The timers started one by one, restart them back to back
+    if (value == Action::Blink)
+    {
+        for (auto* member : members)
+        {
+            member->syncBlink();
+        }
+    }
+    dispatching = false;
+
+    update();
+
+    return state();
+}
+
+uint8_t Logical::dutyOn(uint8_t value)
+{
+    dispatching = true;
+    for (auto* member : members)
+    {
+        member->dutyOn(value);
+    }
+    dispatching = false;
+
+    return sdbusplus::xyz::openbmc_project::Led::server::Physical::dutyOn(
+        value);
+}
+
+uint16_t Logical::period(uint16_t value)
+{
+    dispatching = true;
+    for (auto* member : members)
+    {
+        member->period(value);
+    }
+    dispatching = false;
+
+    return sdbusplus::xyz::openbmc_project::Led::server::Physical::period(
+        value);
+}
+
+void Logical::group()
+{
+    if (grouped ||
+        !std::ranges::all_of(members, &phosphor::led::Physical::isBound))
+    {
+        return;
+    }
+
+    // Members on the same bus device are written back to back
+    std::vector<std::pair<fs::path, phosphor::led::Physical*>> devices;
+    devices.reserve(members.size());
+    for (auto* member : members)
+    {
+        devices.emplace_back(member->getDevice(), member);
+    }
+    std::ranges::stable_sort(devices, {},
+                             &decltype(devices)::value_type::first);
+    std::ranges::copy(devices | std::views::values, members.begin());
+
+    grouped = true;
+}
+
+void Logical::update()
+{
+    auto derived = Action::Off;
+    for (const auto* member : members)
+    {
+        auto value = member->state();
+        if (value == Action::Blink)
+        {
+            derived = Action::Blink;
+            break;
+        }
+        if (value == Action::On)
+        {
+            derived = Action::On;
+        }
+    }
+
+    // Emits PropertiesChanged if the State changed
+    sdbusplus::xyz::openbmc_project::Led::server::Physical::state(derived);
+}
+
+} // namespace led
+} // namespace phosphor
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "physical.hpp"
+
+#include <sdbusplus/bus.hpp>
+
+#include <string>
+#include <vector>
+
+namespace phosphor
+{
+namespace led
+{
+
+/** @class Logical
+ *  @brief An LED object standing for several physical LEDs
+ *
+ *  Implements the same interface as a physical LED. Setting a property
+ *  sets it on all members in one go, members sharing a device are written
+ *  back to back, and blinking members are restarted together so they
+ *  blink in phase. State follows the members: it is Blink if any member
+ *  blinks, On if any member is on and Off otherwise.
+ */
+class Logical : public PhysicalIfaces
+{
+  public:
+    Logical() = delete;
+    ~Logical() override = default;
+    Logical(const Logical&) = delete;
+    Logical& operator=(const Logical&) = delete;
+    Logical(Logical&&) = delete;
+    Logical& operator=(Logical&&) = delete;
+
+    /** @brief Constructs the object of a group of LEDs
+     *
+     * @param[in] bus       - system dbus handler
+     * @param[in] objPath   - The Dbus path that hosts the group
+     * @param[in] members   - the LEDs of the group, they have to outlive it
+     * @param[in] deferSignals - hold off the InterfacesAdded signal, the
+     *                           caller then has to emit_object_added()
+     */
+    Logical(sdbusplus::bus_t& bus, const std::string& objPath,
+            std::vector<phosphor::led::Physical*> members,
+            bool deferSignals = false);
+
+    /** @brief Sets State on all members
+     *
+     *  @param[in] value   -  One of OFF / ON / BLINK
+     *  @return            -  The State derived from the members
+     */
+    Action state(Action value) override;
+
+    /** @brief State derived from the members */
+    Action state() const override;
+
+    using sdbusplus::xyz::openbmc_project::Led::server::Physical::dutyOn;
+    using sdbusplus::xyz::openbmc_project::Led::server::Physical::period;
+
+    /** @brief Sets DutyOn on all members
+     *
+     *  @param[in] value   -  Percentage of the period the LED is on
+     *  @return            -  The new value
+     */
+    uint8_t dutyOn(uint8_t value) override;
+
+    /** @brief Sets Period on all members
+     *
+     *  @param[in] value   -  Blink period in milliseconds
+     *  @return            -  The new value
+     */
+    uint16_t period(uint16_t value) override;
+
+    /** @brief Sets the queue the State writes of the members are batched
+     *  in
+     *
+     *  @param[in] queue - the queue shared by all LEDs
+     */
+    void setWriteQueue(WriteQueue* queue)
+    {
+        writeQueue = queue;
+    }
+
+  private:
+    /** @brief The LEDs of the group, ordered by device */
+    std::vector<phosphor::led::Physical*> members;
+
+    /** @brief The members are ordered by their devices */
+    bool grouped = false;
+
+    /** @brief A setter is writing to the members */
+    bool dispatching = false;
+
+    /** @brief Queue batching the State writes of the members */
+    WriteQueue* writeQueue = nullptr;
+
+    /** @brief Orders the members by device once all are bound */
+    void group();
+
+    /** @brief Updates State from the members */
+    void update();
+};
+
+} // namespace led
+} // namespace phosphor
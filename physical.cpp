@@ -16,20 +16,84 @@
 
 #include "physical.hpp"
 
+#include "arbiter.hpp"
+
+#include <sys/epoll.h>
+
+#include <phosphor-logging/lg2.hpp>
+#include <xyz/openbmc_project/Common/error.hpp>
+
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <optional>
 #include <string>
+#include <typeinfo>
 namespace phosphor
 {
 namespace led
 {
 
+Physical::Physical(sdbusplus::bus_t& bus, const std::string& objPath,
+                   const std::string& color, std::optional<Action> initial,
+                   bool deferSignals) :
+    PhysicalIfaces(bus, objPath.c_str(), PhysicalIfaces::action::defer_emit),
+    triggers(&getTriggerSet({})), activeTrigger("none"),
+    adoptHardware(!initial)
+{
+    sdbusplus::xyz::openbmc_project::Led::server::Physical::state(
+        initial.value_or(Action::Off));
+
+    setLedColor(color);
+
+    if (!deferSignals)
+    {
+        emit_object_added();
+    }
+}
+
+Physical::~Physical()
+{
+    if (sequencer != nullptr)
+    {
+        sequencer->stop(this);
+    }
+
+    if (frames != nullptr)
+    {
+        frames->forget(this);
+    }
+
+    if (limiter != nullptr)
+    {
+        limiter->remove(this);
+    }
+
+    if (retrier != nullptr)
+    {
+        retrier->cancel(this);
+    }
+
+    if (monitor != nullptr)
+    {
+        monitor->remove(this);
+    }
+
+    if (writeQueue != nullptr)
+    {
+        writeQueue->cancel(this);
+    }
+}
+
 /** @brief Populates key parameters */
 void Physical::setInitialState()
 {
-    assert = led->getMaxBrightness();
+    setCapabilities();
     auto trigger = led->getTrigger();
+    activeTrigger = trigger;
     if (trigger == "timer")
     {
         // LED is blinking. Get the on and off delays and derive percent duty
@@ -47,6 +111,8 @@ void Physical::setInitialState()
         auto brightness = led->getBrightness();
         if (brightness != 0U && assert != 0U)
         {
+            // Keep a dimmed LED dimmed
+            level = toLevel(*levels, brightness);
             sdbusplus::xyz::openbmc_project::Led::server::Physical::state(
                 Action::On);
         }
@@ -58,49 +124,412 @@ void Physical::setInitialState()
     }
 }
 
+void Physical::setCapabilities()
+{
+    assert = led->getMaxBrightness();
+    levels = &getBrightnessTable(assert);
+    triggers = &getTriggerSet(led->getTriggers());
+}
+
+void Physical::bind(std::unique_ptr<phosphor::led::SysfsLed> sysfsLed)
+{
+    led = std::move(sysfsLed);
+
+    if (adoptHardware)
+    {
+        // Nothing was asked for, keep what the LED shows
+        setInitialState();
+    }
+    else
+    {
+        setCapabilities();
+
+        // Apply what was asked for while the device was missing
+        auto current = state();
+        if (current == Action::Blink)
+        {
+            blinkOperation();
+        }
+        else
+        {
+            stableStateOperation(current);
+        }
+    }
+    setInitialColor();
+
+    notifyChange();
+}
+
+void Physical::setInitialColor()
+{
+    if (!led->hasAttr("multi_index"))
+    {
+        return;
+    }
+
+    multicolor = std::make_unique<MultiColor>();
+    multicolor->channels = led->getMultiIndex();
+    multicolor->intensity = led->getMultiIntensity();
+    multicolor->intensity.resize(multicolor->channels.size());
+
+    for (const auto& channel : multicolor->channels)
+    {
+        using Source = MultiColor::Source;
+
+        auto source = Source::none;
+        if (channel == "red")
+        {
+            source = Source::red;
+        }
+        else if (channel == "green")
+        {
+            source = Source::green;
+        }
+        else if (channel == "blue")
+        {
+            source = Source::blue;
+        }
+        else if (channel == "white")
+        {
+            source = Source::white;
+        }
+        multicolor->sources.emplace_back(source);
+    }
+}
+
 auto Physical::state() const -> Action
 {
     return sdbusplus::xyz::openbmc_project::Led::server::Physical::state();
 }
 
 auto Physical::state(Action value) -> Action
+{
+    if (arbiter != nullptr)
+    {
+        return arbiter->direct(*this, value);
+    }
+
+    return setState(value);
+}
+
+auto Physical::setState(Action value) -> Action
 {
     auto current =
         sdbusplus::xyz::openbmc_project::Led::server::Physical::state();
 
-    auto requested =
-        sdbusplus::xyz::openbmc_project::Led::server::Physical::state(value);
+    sdbusplus::xyz::openbmc_project::Led::server::Physical::state(value);
+
+    if (deferredFrom)
+    {
+        // The deferred write applies the latest State
+        ++mergedWrites;
+    }
+    else if (limiter != nullptr && led && !isApplied(current, value) &&
+             !limiter->acquire(this))
+    {
+        ++deferredWrites;
+        deferredFrom = current;
+        limiter->defer(this, [this]() {
+            auto from = *deferredFrom;
+            deferredFrom.reset();
+            writeState(from, 0);
+            notifyChange();
+        });
+    }
+    else
+    {
+        writeState(current, 0);
+    }
 
-    driveLED(current, requested);
+    notifyChange();
 
     return value;
 }
 
-void Physical::driveLED(Action current, Action request)
+uint8_t Physical::dutyOn(uint8_t value)
+{
+    auto rc =
+        sdbusplus::xyz::openbmc_project::Led::server::Physical::dutyOn(value);
+
+    notifyChange();
+
+    return rc;
+}
+
+uint16_t Physical::period(uint16_t value)
+{
+    auto rc =
+        sdbusplus::xyz::openbmc_project::Led::server::Physical::period(value);
+
+    notifyChange();
+
+    return rc;
+}
+
+void Physical::onChange(ChangeCallback callback)
+{
+    changeCallbacks.emplace_back(std::move(callback));
+}
+
+void Physical::notifyChange()
+{
+    for (const auto& callback : changeCallbacks)
+    {
+        callback();
+    }
+}
+
+void Physical::writeState(Action from, unsigned attempt)
+{
+    // Queued writes go straight to the attribute files, an LED overriding
+    // its writes, e.g. a mock, is written through them instead. Writes
+    // following queued ones are queued too, so they stay in order
+    if (writeQueue != nullptr && led && typeid(*led) == typeid(SysfsLed) &&
+        (writeQueue->isBatching() || writeQueue->isPending(this)))
+    {
+        QueuedSysfsLed collect(*led);
+        queued = &collect;
+        auto rc = driveLED(from, state());
+        queued = nullptr;
+
+        // The writes block the dispatch submitting or reaping them
+        if (monitor != nullptr)
+        {
+            monitor->touch(this);
+        }
+
+        auto writes = collect.take();
+        if (rc == 0 && !writes.empty())
+        {
+            // Every queued State is reported on with the result of the
+            // latest, which alone acts on it. A failure rolls back to the
+            // State before the first of them.
+            if (!writeQueue->isPending(this))
+            {
+                queuedFrom = from;
+            }
+            writeQueue->enqueue(this, std::move(writes),
+                                [this, origin = queuedFrom, attempt,
+                                 generation = ++queueGeneration](int result) {
+                                    if (generation == queueGeneration &&
+                                        result != 0)
+                                    {
+                                        writeFailed(origin, attempt, result);
+                                    }
+                                });
+        }
+        else if (rc != 0)
+        {
+            writeFailed(from, attempt, rc);
+        }
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto rc = driveLED(from, state());
+    if (monitor != nullptr && led)
+    {
+        using namespace std::chrono;
+        auto elapsed = steady_clock::now() - start;
+        monitor->record(this, duration_cast<microseconds>(elapsed));
+    }
+
+    if (rc != 0)
+    {
+        writeFailed(from, attempt, rc);
+    }
+}
+
+void Physical::writeFailed(Action from, unsigned attempt, int rc)
 {
-    if (current == request)
+    ++failedWrites;
+
+    if (retrier != nullptr && RetryScheduler::isTransient(rc) &&
+        retrier->retry(this, attempt, [this, from, attempt]() {
+            writeState(from, attempt + 1);
+        }))
     {
         return;
     }
 
+    ++abandonedWrites;
+    lg2::error("Giving up setting LED State {STATE}: {ERROR}", "STATE",
+               convertActionToString(state()), "ERROR", strerror(-rc));
+
+    // Publish the State before the write rather than the one requested. A
+    // partial write, e.g. the timer trigger without its delays, left the
+    // LED in neither, so it is driven back first
+    sdbusplus::xyz::openbmc_project::Led::server::Physical::state(from);
+    restoreState();
+    notifyChange();
+}
+
+void Physical::restoreState()
+{
+    stopPlayback();
+    triggerParams.clear();
+
+    auto current = state();
+    auto rc = (current == Action::Blink) ? blinkOperation()
+                                         : stableStateOperation(current);
+    if (rc != 0)
+    {
+        // The scrubber corrects the LED once the device responds again
+        lg2::error("Unable to restore LED State {STATE}: {ERROR}", "STATE",
+                   convertActionToString(current), "ERROR", strerror(-rc));
+    }
+}
+
+template <typename Write>
+int Physical::writeBackend(Write&& write)
+{
+    if (queued != nullptr)
+    {
+        return write(*queued);
+    }
+
+    return write(*led);
+}
+
+int Physical::driveLED(Action current, Action request)
+{
+    // State is applied once the device is bound
+    if (!led)
+    {
+        adoptHardware = false;
+        return 0;
+    }
+
+    if (isApplied(current, request))
+    {
+        return 0;
+    }
+
+    stopPlayback();
+    triggerParams.clear();
+
+    // Only turning a steady LED on or off fades
+    if (request == Action::On && current == Action::Off && fadeIn != 0)
+    {
+        return fadeOperation(0, level, fadeIn);
+    }
+
+    if (request == Action::Off && current == Action::On && fadeOut != 0)
+    {
+        return fadeOperation(level, 0, fadeOut);
+    }
+
     if (request == Action::On || request == Action::Off)
     {
         return stableStateOperation(request);
     }
 
     assert(request == Action::Blink);
-    blinkOperation();
+    return blinkOperation();
+}
+
+bool Physical::isApplied(Action current, Action request) const
+{
+    // A kernel trigger set by setTrigger() or a pattern leave State
+    // untouched, so the LED has to be taken back even if State does not
+    // change
+    bool offloaded = activeTrigger != "none" && activeTrigger != "timer";
+    bool playing = sequencer != nullptr && sequencer->isActive(this);
+
+    return current == request && !offloaded && !playing;
 }
 
-void Physical::stableStateOperation(Action action)
+int Physical::stableStateOperation(Action action)
 {
-    auto value = (action == Action::On) ? assert : deasserted;
+    auto value = (action == Action::On) ? toBrightness(maxLevel) : deasserted;
 
-    led->setTrigger("none");
-    led->setBrightness(value);
+    auto rc = writeBackend(
+        [value](auto& backend) { return writeSteady(backend, value); });
+    activeTrigger = "none";
+
+    return rc;
 }
 
-void Physical::blinkOperation()
+int Physical::fadeOperation(uint8_t from, uint8_t to, uint16_t duration)
+{
+    const auto& table = *levels;
+
+    if (triggers->contains(KnownTrigger::pattern))
+    {
+        // The kernel ramps linearly between steps and updates the ramp
+        // every 50ms, a few segments follow the gamma curve closely enough
+        int segments = std::clamp(duration / 50, 1, 10);
+        std::string steps;
+        for (int i = 0; i <= segments; i++)
+        {
+            auto step = from + ((to - from) * i / segments);
+            auto time = (i == segments) ? 0 : duration / segments;
+            steps += std::to_string(table[step]) + " " +
+                     std::to_string(time) + " ";
+        }
+        steps.pop_back();
+
+        auto rc = led->setTrigger("pattern");
+        activeTrigger = "pattern";
+        triggerParams = {{"repeat", "1"}, {"pattern", steps}};
+        if (rc == 0)
+        {
+            rc = led->setTriggerAttr("repeat", "1");
+        }
+        if (rc == 0)
+        {
+            rc = led->setTriggerAttr("pattern", steps);
+        }
+        kernelFade = true;
+        return rc;
+    }
+
+    auto rc = led->setTrigger("none");
+    activeTrigger = "none";
+
+    if (frames == nullptr || rc != 0)
+    {
+        return rc != 0 ? rc : led->setBrightness(table[to]);
+    }
+
+    // Frames are rewritten by the next one, a lost frame is not retried
+    frames->start(this, {levels, from, to, std::chrono::milliseconds(duration),
+                         [this](unsigned long value) {
+                             led->setBrightness(value);
+                         }});
+    return 0;
+}
+
+void Physical::stopPlayback()
+{
+    if (sequencer != nullptr)
+    {
+        sequencer->stop(this);
+    }
+
+    if (frames != nullptr)
+    {
+        frames->stop(this);
+    }
+
+    pulsing = false;
+    kernelFade = false;
+
+    // Whatever stops playback also supersedes a deferred State
+    if (deferredFrom && limiter != nullptr)
+    {
+        limiter->cancel(this);
+        deferredFrom.reset();
+    }
+
+    // and the retry of a failed one
+    if (retrier != nullptr)
+    {
+        retrier->cancel(this);
+    }
+}
+
+int Physical::blinkOperation()
 {
     /*
       The configuration of the trigger type must precede the configuration of
@@ -112,17 +541,631 @@ void Physical::blinkOperation()
       Refer:
       https://git.kernel.org/pub/scm/linux/kernel/git/torvalds/linux.git/tree/Documentation/leds/leds-class.txt?h=v5.2#n26
     */
-    auto d = static_cast<unsigned long>(dutyOn());
-    if (d > 100)
+    auto [on, off] = blinkDelays();
+
+    // The timer trigger blinks with the brightness written while it runs
+    std::optional<unsigned long> brightness;
+    if (level < maxLevel)
     {
-        d = 100;
+        brightness = toBrightness(maxLevel);
     }
 
+    auto rc = writeBackend([&](auto& backend) {
+        return writeBlink(backend, on, off, brightness);
+    });
+    activeTrigger = "timer";
+    roundedDelays = false;
+
+    return rc;
+}
+
+std::pair<unsigned long, unsigned long> Physical::blinkDelays() const
+{
+    auto d = std::min(static_cast<unsigned long>(dutyOn()), 100UL);
     auto p = static_cast<unsigned long>(period());
+    return {p * d / 100UL, p * (100UL - d) / 100UL};
+}
+
+void Physical::syncBlink()
+{
+    if (!led || activeTrigger != "timer")
+    {
+        return;
+    }
+
+    // Queued timers start together from a single submission already
+    if (writeQueue != nullptr && writeQueue->isPending(this))
+    {
+        return;
+    }
+
+    // Writing a delay restarts the kernel timer, the scrubber corrects a
+    // failed one
+    auto rc = led->setDelayOff(blinkDelays().second);
+    if (rc != 0)
+    {
+        lg2::error("Unable to restart the LED blink: {ERROR}", "ERROR",
+                   strerror(-rc));
+    }
+}
+
+void Physical::setTrigger(const std::string& trigger,
+                          const TriggerParams& params)
+{
+    using sdbusplus::xyz::openbmc_project::Common::Error::InternalFailure;
+    using sdbusplus::xyz::openbmc_project::Common::Error::InvalidArgument;
+    using sdbusplus::xyz::openbmc_project::Common::Error::Unavailable;
+
+    if (!led)
+    {
+        throw Unavailable();
+    }
+
+    if (!triggers->contains(trigger))
+    {
+        lg2::error("Trigger {TRIGGER} is not supported", "TRIGGER", trigger);
+        throw InvalidArgument();
+    }
+
+    for (const auto& [attr, value] : params)
+    {
+        if (std::ranges::find(triggerAttrs, attr) == triggerAttrs.end())
+        {
+            lg2::error("Trigger attribute {ATTR} is not supported", "ATTR",
+                       attr);
+            throw InvalidArgument();
+        }
+    }
+
+    auto rc = applyTrigger(trigger, params);
+    if (rc != 0)
+    {
+        lg2::error("Unable to set trigger {TRIGGER}: {ERROR}", "TRIGGER",
+                   trigger, "ERROR", strerror(-rc));
+        restoreState();
+        notifyChange();
+        throw InternalFailure();
+    }
+
+    notifyChange();
+}
+
+int Physical::applyTrigger(const std::string& trigger,
+                           const TriggerParams& params)
+{
+    stopPlayback();
+
+    activeTrigger = trigger;
+    triggerParams = params;
+
+    // The attributes only appear once the trigger is selected
+    auto rc = led->setTrigger(trigger);
+    for (const auto* attr : triggerAttrs)
+    {
+        auto it = params.find(attr);
+        if (rc == 0 && it != params.end())
+        {
+            rc = led->setTriggerAttr(it->first, it->second);
+        }
+    }
+
+    return rc;
+}
+
+unsigned long Physical::toBrightness(uint8_t percent) const
+{
+    return (*levels)[percent * level / maxLevel];
+}
+
+void Physical::setPattern(const Pattern& pattern, int32_t repeat)
+{
+    using sdbusplus::xyz::openbmc_project::Common::Error::InternalFailure;
+    using sdbusplus::xyz::openbmc_project::Common::Error::InvalidArgument;
+    using sdbusplus::xyz::openbmc_project::Common::Error::Unavailable;
+    using sdbusplus::xyz::openbmc_project::Common::Error::UnsupportedRequest;
+
+    if (!led)
+    {
+        throw Unavailable();
+    }
+
+    bool timed = std::ranges::any_of(
+        pattern, [](const auto& step) { return step.duration != 0; });
+    bool valid = std::ranges::all_of(
+        pattern, [](const auto& step) { return step.brightness <= 100; });
+    if (!timed || !valid || (repeat != repeatForever && repeat <= 0))
+    {
+        lg2::error("Invalid pattern of {STEPS} steps, repeat {REPEAT}",
+                   "STEPS", pattern.size(), "REPEAT", repeat);
+        throw InvalidArgument();
+    }
+
+    stopPlayback();
+
+    int rc = 0;
+    if (triggers->contains(KnownTrigger::pattern))
+    {
+        // Each step is held, the kernel would ramp between steps otherwise
+        std::string steps;
+        for (const auto& step : pattern)
+        {
+            auto value = std::to_string(toBrightness(step.brightness));
+            steps += value + " " + std::to_string(step.duration) + " " +
+                     value + " 0 ";
+        }
+        steps.pop_back();
+
+        // Prefer the driver's own sequencer over the kernel timer
+        auto attr = led->hasAttr("hw_pattern") ? "hw_pattern" : "pattern";
+        rc = applyTrigger("pattern",
+                          {{"repeat", std::to_string(repeat)}, {attr, steps}});
+    }
+    else if (sequencer != nullptr)
+    {
+        rc = applyTrigger("none", {});
+        if (rc == 0)
+        {
+            // A lost step is rewritten by the next one, it is not retried
+            sequencer->start(this, pattern, repeat, [this](uint8_t percent) {
+                led->setBrightness(toBrightness(percent));
+            });
+        }
+    }
+    else
+    {
+        lg2::error("No way to play a pattern");
+        throw UnsupportedRequest();
+    }
+
+    if (rc != 0)
+    {
+        lg2::error("Unable to start the pattern: {ERROR}", "ERROR",
+                   strerror(-rc));
+        restoreState();
+        notifyChange();
+        throw InternalFailure();
+    }
+
+    notifyChange();
+}
+
+void Physical::setIntensity(const std::vector<unsigned long>& intensity)
+{
+    using sdbusplus::xyz::openbmc_project::Common::Error::InternalFailure;
+    using sdbusplus::xyz::openbmc_project::Common::Error::InvalidArgument;
+    using sdbusplus::xyz::openbmc_project::Common::Error::UnsupportedRequest;
+
+    if (!multicolor)
+    {
+        throw UnsupportedRequest();
+    }
+
+    if (intensity.size() != multicolor->channels.size() ||
+        std::ranges::any_of(intensity,
+                            [this](auto value) { return value > assert; }))
+    {
+        lg2::error("Invalid intensity for {CHANNELS} channels", "CHANNELS",
+                   multicolor->channels.size());
+        throw InvalidArgument();
+    }
+
+    // The kernel reapplies the brightness with the new intensities, a
+    // failed write keeps the ones before
+    auto rc = led->setMultiIntensity(intensity);
+    if (rc != 0)
+    {
+        lg2::error("Unable to set the LED intensity: {ERROR}", "ERROR",
+                   strerror(-rc));
+        throw InternalFailure();
+    }
+    multicolor->intensity = intensity;
+
+    notifyChange();
+}
+
+void Physical::setColor(uint8_t red, uint8_t green, uint8_t blue)
+{
+    using sdbusplus::xyz::openbmc_project::Common::Error::UnsupportedRequest;
+    using Source = MultiColor::Source;
+
+    if (!multicolor)
+    {
+        throw UnsupportedRequest();
+    }
+
+    // Intensities are on the scale of max_brightness
+    auto scale = [this](uint8_t value) { return assert * value / 255; };
+
+    // A white channel takes over the common part of the components
+    uint8_t white = 0;
+    if (std::ranges::find(multicolor->sources, Source::white) !=
+        multicolor->sources.end())
+    {
+        white = std::min({red, green, blue});
+        red -= white;
+        green -= white;
+        blue -= white;
+    }
+
+    std::vector<unsigned long> intensity;
+    intensity.reserve(multicolor->sources.size());
+    for (auto source : multicolor->sources)
+    {
+        switch (source)
+        {
+            case Source::red:
+                intensity.emplace_back(scale(red));
+                break;
+            case Source::green:
+                intensity.emplace_back(scale(green));
+                break;
+            case Source::blue:
+                intensity.emplace_back(scale(blue));
+                break;
+            case Source::white:
+                intensity.emplace_back(scale(white));
+                break;
+            case Source::none:
+                intensity.emplace_back(0);
+                break;
+        }
+    }
+
+    setIntensity(intensity);
+}
+
+void Physical::pulse(uint16_t duration)
+{
+    using sdbusplus::xyz::openbmc_project::Common::Error::InternalFailure;
+    using sdbusplus::xyz::openbmc_project::Common::Error::InvalidArgument;
+    using sdbusplus::xyz::openbmc_project::Common::Error::NotAllowed;
+    using sdbusplus::xyz::openbmc_project::Common::Error::Unavailable;
+    using sdbusplus::xyz::openbmc_project::Common::Error::UnsupportedRequest;
+
+    if (duration == 0)
+    {
+        throw InvalidArgument();
+    }
+
+    if (!led)
+    {
+        throw Unavailable();
+    }
+
+    // A pulse flips a steady LED for the duration
+    auto current = state();
+    if (current == Action::Blink)
+    {
+        lg2::error("Unable to pulse a blinking LED");
+        throw NotAllowed();
+    }
+    bool on = current == Action::On;
+    auto ms = std::to_string(duration);
+
+    // A trigger armed only in part is taken back, the LED returns to State
+    auto arm = [this](const std::string& trigger,
+                      const TriggerParams& params) {
+        auto rc = applyTrigger(trigger, params);
+        if (rc != 0)
+        {
+            lg2::error("Unable to arm the pulse: {ERROR}", "ERROR",
+                       strerror(-rc));
+            restoreState();
+        }
+        notifyChange();
+        if (rc != 0)
+        {
+            throw InternalFailure();
+        }
+    };
+    auto fire = [this](const std::string& attr) {
+        auto rc = led->setTriggerAttr(attr, "1");
+        if (rc != 0)
+        {
+            lg2::error("Unable to pulse the LED: {ERROR}", "ERROR",
+                       strerror(-rc));
+            throw InternalFailure();
+        }
+    };
+
+    // Once armed, a kernel pulse is a single write which the kernel
+    // ignores (oneshot) or extends (transient) while a pulse is active
+    if (triggers->contains(KnownTrigger::oneshot))
+    {
+        TriggerParams params = {
+            {"delay_on", ms}, {"delay_off", ms}, {"invert", on ? "1" : "0"}};
+        if (activeTrigger != "oneshot" || triggerParams != params)
+        {
+            arm("oneshot", params);
+        }
+        fire("shot");
+        return;
+    }
+
+    if (triggers->contains(KnownTrigger::transient))
+    {
+        TriggerParams params = {{"duration", ms}, {"state", on ? "0" : "1"}};
+        if (activeTrigger != "transient" || triggerParams != params)
+        {
+            arm("transient", params);
+        }
+        fire("activate");
+        return;
+    }
+
+    if (sequencer == nullptr)
+    {
+        lg2::error("No way to pulse the LED");
+        throw UnsupportedRequest();
+    }
+
+    if (pulsing && sequencer->isActive(this))
+    {
+        return;
+    }
+
+    if (activeTrigger != "none")
+    {
+        arm("none", {});
+    }
+    else
+    {
+        stopPlayback();
+    }
+
+    uint8_t lit = on ? 0 : 100;
+    uint8_t idle = on ? 100 : 0;
+    sequencer->start(this, {{lit, duration}, {idle, 0}}, 1,
+                     [this](uint8_t percent) {
+                         led->setBrightness(toBrightness(percent));
+                     });
+    pulsing = true;
+}
+
+void Physical::setLevel(uint8_t value)
+{
+    using sdbusplus::xyz::openbmc_project::Common::Error::InternalFailure;
+    using sdbusplus::xyz::openbmc_project::Common::Error::InvalidArgument;
+
+    // Turning the LED off is up to State
+    if (value == 0 || value > maxLevel)
+    {
+        lg2::error("Invalid brightness level {LEVEL}", "LEVEL", value);
+        throw InvalidArgument();
+    }
+
+    if (value == level)
+    {
+        return;
+    }
+    auto previous = std::exchange(level, value);
+
+    if (!led)
+    {
+        notifyChange();
+        return;
+    }
+
+    // Triggers, patterns, fades and deferred writes pick the level up when
+    // they are next applied
+    auto current = state();
+    bool playing = (sequencer != nullptr && sequencer->isActive(this)) ||
+                   (frames != nullptr && frames->isActive(this)) ||
+                   deferredFrom.has_value() ||
+                   (retrier != nullptr && retrier->isPending(this)) ||
+                   (writeQueue != nullptr && writeQueue->isPending(this));
+    int rc = 0;
+    if (current == Action::On && kernelFade)
+    {
+        // Take the LED back from the pattern trigger holding the fade
+        kernelFade = false;
+        triggerParams.clear();
+        rc = stableStateOperation(Action::On);
+    }
+    else if (!playing &&
+             ((current == Action::On && activeTrigger == "none") ||
+              (current == Action::Blink && activeTrigger == "timer")))
+    {
+        rc = led->setBrightness(toBrightness(maxLevel));
+    }
+
+    if (rc != 0)
+    {
+        // The LED still shows the level before
+        lg2::error("Unable to apply brightness level {LEVEL}: {ERROR}",
+                   "LEVEL", value, "ERROR", strerror(-rc));
+        level = previous;
+        throw InternalFailure();
+    }
+
+    notifyChange();
+}
+
+void Physical::watchHardware(const sdeventplus::Event& event)
+{
+    if (!led)
+    {
+        return;
+    }
+
+    int fd = led->getHwChangedFd();
+    if (fd < 0)
+    {
+        return;
+    }
+
+    // sysfs_notify() wakes pollers with POLLPRI
+    hardwareWatch.emplace(event, fd, EPOLLPRI,
+                          [this](auto&, int, uint32_t) { hardwareChanged(); });
+}
+
+void Physical::hardwareChanged()
+{
+    // Reading the attribute also rearms the notification
+    auto brightness = led->getBrightnessHwChanged();
+    if (!brightness)
+    {
+        return;
+    }
+
+    auto value = (*brightness != 0U) ? Action::On : Action::Off;
+    if (value == state())
+    {
+        return;
+    }
+
+    lg2::debug("Hardware set LED brightness to {BRIGHTNESS}", "BRIGHTNESS",
+               *brightness);
+
+    // The hardware owns the LED now, do not step over it
+    stopPlayback();
+
+    // Emits PropertiesChanged, nothing is written to the LED
+    sdbusplus::xyz::openbmc_project::Led::server::Physical::state(value);
+
+    notifyChange();
+}
+
+bool Physical::scrub()
+{
+    if (!led)
+    {
+        return false;
+    }
+
+    auto current = state();
+    bool playing = (sequencer != nullptr && sequencer->isActive(this)) ||
+                   (frames != nullptr && frames->isActive(this)) ||
+                   deferredFrom.has_value() ||
+                   (retrier != nullptr && retrier->isPending(this)) ||
+                   (writeQueue != nullptr && writeQueue->isPending(this));
+    if (playing)
+    {
+        return false;
+    }
+
+    if (current == Action::Blink || activeTrigger != "none")
+    {
+        return scrubTrigger();
+    }
+
+    // Only a steady LED has a known brightness
+    auto expected =
+        (current == Action::On) ? toBrightness(maxLevel) : deasserted;
+    auto actual = led->getBrightness();
+    if (actual == expected)
+    {
+        return false;
+    }
+
+    lg2::warning("LED brightness drifted from {EXPECTED} to {ACTUAL}",
+                 "EXPECTED", expected, "ACTUAL", actual);
+
+    auto shown = (actual != 0U) ? Action::On : Action::Off;
+    if (hardwareWatch && shown != current)
+    {
+        sdbusplus::xyz::openbmc_project::Led::server::Physical::state(shown);
+        notifyChange();
+    }
+    else if (auto rc = stableStateOperation(current); rc != 0)
+    {
+        // The next check tries again
+        lg2::error("Unable to correct the LED: {ERROR}", "ERROR",
+                   strerror(-rc));
+    }
+
+    return true;
+}
+
+bool Physical::scrubTrigger()
+{
+    // A driver reset drops the trigger, the cached one would hide that
+    led->invalidateTrigger();
+    auto trigger = led->getTrigger();
+    if (trigger == activeTrigger &&
+        (activeTrigger != "timer" || roundedDelays ||
+         std::pair(led->getDelayOn(), led->getDelayOff()) == blinkDelays()))
+    {
+        return false;
+    }
+
+    lg2::warning("LED trigger drifted from {EXPECTED} to {ACTUAL}",
+                 "EXPECTED", activeTrigger, "ACTUAL", trigger);
+
+    int rc = 0;
+    if (activeTrigger == "timer")
+    {
+        rc = blinkOperation();
+
+        // Drivers blinking in hardware may round the delays, only the
+        // trigger is compared from now on
+        roundedDelays = trigger == "timer" &&
+                        std::pair(led->getDelayOn(), led->getDelayOff()) !=
+                            blinkDelays();
+    }
+    else if (kernelFade)
+    {
+        // Replaying the fade would flash the LED, it is set to its end
+        stopPlayback();
+        rc = stableStateOperation(state());
+    }
+    else
+    {
+        auto params = triggerParams;
+        rc = applyTrigger(std::string(activeTrigger), params);
+    }
+
+    if (rc != 0)
+    {
+        // The next check tries again
+        lg2::error("Unable to correct the LED trigger: {ERROR}", "ERROR",
+                   strerror(-rc));
+    }
+
+    return true;
+}
+
+void Physical::setFadeIn(uint16_t value)
+{
+    using sdbusplus::xyz::openbmc_project::Common::Error::UnsupportedRequest;
+
+    // An on/off LED has nothing to fade through, an unbound one may
+    if (value != 0 && led && assert <= 1)
+    {
+        throw UnsupportedRequest();
+    }
+
+    fadeIn = value;
+
+    notifyChange();
+}
+
+void Physical::setFadeOut(uint16_t value)
+{
+    using sdbusplus::xyz::openbmc_project::Common::Error::UnsupportedRequest;
+
+    if (value != 0 && led && assert <= 1)
+    {
+        throw UnsupportedRequest();
+    }
+
+    fadeOut = value;
+
+    notifyChange();
+}
+
+void Physical::stopPattern()
+{
+    bool playing = sequencer != nullptr && sequencer->isActive(this);
+    if (activeTrigger != "pattern" && !playing)
+    {
+        return;
+    }
+
+    auto current = state();
+    writeState(current, 0);
 
-    led->setTrigger("timer");
-    led->setDelayOn(p * d / 100UL);
-    led->setDelayOff(p * (100UL - d) / 100UL);
+    notifyChange();
 }
 
 /** @brief set led color property in DBus*/
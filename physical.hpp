@@ -1,13 +1,30 @@
 #pragma once
 
+#include "frame_scheduler.hpp"
+#include "gamma.hpp"
+#include "lag_monitor.hpp"
+#include "led_backend.hpp"
+#include "rate_limiter.hpp"
+#include "retry_scheduler.hpp"
+#include "sequencer.hpp"
 #include "sysfs.hpp"
+#include "triggers.hpp"
+#include "write_queue.hpp"
 
 #include <sdbusplus/bus.hpp>
 #include <sdbusplus/server/object.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
 #include <xyz/openbmc_project/Led/Physical/server.hpp>
 
+#include <array>
 #include <fstream>
+#include <functional>
+#include <map>
+#include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace fs = std::filesystem;
 
@@ -15,9 +32,50 @@ namespace phosphor
 {
 namespace led
 {
+
 /** @brief De-assert value */
 constexpr unsigned long deasserted = 0;
 
+/** @brief Trigger attributes a client may set, in the order they are
+ *   written. Some triggers act on the last one, e.g. transient's activate.
+ */
+constexpr std::array<const char*, 26> triggerAttrs = {
+    "device_name", "ttyname",   "interval",  "link",        "link_10",
+    "link_100",    "link_1000", "half_duplex", "full_duplex", "rx",
+    "tx",          "cts",       "dsr",       "dcd",         "rng",
+    "invert",      "inverted",  "delay_on",  "delay_off",   "duration",
+    "state",       "repeat",    "pattern",   "hw_pattern",  "shot",
+    "activate",
+};
+
+/** @brief Trigger attribute values by attribute name */
+using TriggerParams = std::map<std::string, std::string>;
+
+/** @brief Channels of a multicolor LED */
+struct MultiColor
+{
+    /** @brief Component of an RGB color feeding a channel */
+    enum class Source : uint8_t
+    {
+        red,
+        green,
+        blue,
+        white,
+        none,
+    };
+
+    /** @brief Channel colors as listed in multi_index */
+    std::vector<std::string> channels;
+
+    /** @brief Current channel intensities */
+    std::vector<unsigned long> intensity;
+
+    /** @brief RGB component of each channel, resolved on creation */
+    std::vector<Source> sources;
+};
+
+class Arbiter;
+
 using PhysicalIfaces = sdbusplus::server::object_t<
     sdbusplus::xyz::openbmc_project::Led::server::Physical>;
 
@@ -28,7 +86,7 @@ class Physical : public PhysicalIfaces
 {
   public:
     Physical() = delete;
-    ~Physical() override = default;
+    ~Physical() override;
     Physical(const Physical&) = delete;
     Physical& operator=(const Physical&) = delete;
     Physical(Physical&&) = delete;
@@ -43,11 +101,13 @@ class Physical : public PhysicalIfaces
      * @param[in] objPath   - The Dbus path that hosts physical LED
      * @param[in] ledPath   - sysfs path where this LED is exported
      * @param[in] color     - led color name
+     * @param[in] deferSignals - hold off the InterfacesAdded signal, the
+     *                           caller then has to emit_object_added()
      */
 
     Physical(sdbusplus::bus_t& bus, const std::string& objPath,
              std::unique_ptr<phosphor::led::SysfsLed> led,
-             const std::string& color = "") :
+             const std::string& color = "", bool deferSignals = false) :
         PhysicalIfaces(bus, objPath.c_str(),
                        PhysicalIfaces::action::defer_emit),
         led(std::move(led))
@@ -55,63 +115,575 @@ class Physical : public PhysicalIfaces
         // Suppose this is getting launched as part of BMC reboot, then we
         // need to save what the micro-controller currently has.
         setInitialState();
+        setInitialColor();
 
         // Read led color from environment and set it in DBus.
         setLedColor(color);
 
-        // We are now ready.
-        emit_object_added();
+        // We are now ready, unless the caller batches the signals.
+        if (!deferSignals)
+        {
+            emit_object_added();
+        }
     }
 
+    /** @brief Constructs the object of an LED whose sysfs device does not
+     *   exist yet. State and the other properties are kept until bind()
+     *   attaches the device.
+     *
+     * @param[in] bus       - system dbus handler
+     * @param[in] objPath   - The Dbus path that hosts physical LED
+     * @param[in] color     - led color name
+     * @param[in] initial   - State to apply once bound, nullopt keeps what
+     *                        the LED shows unless State is set before
+     * @param[in] deferSignals - hold off the InterfacesAdded signal, the
+     *                           caller then has to emit_object_added()
+     */
+
+    Physical(sdbusplus::bus_t& bus, const std::string& objPath,
+             const std::string& color, std::optional<Action> initial,
+             bool deferSignals = false);
+
+    /** @brief Attaches the sysfs device of an LED created without one
+     *
+     *  Reads the device and applies State to it, unless the LED is to
+     *  keep what it shows.
+     *
+     *  @param[in] led - the sysfs LED
+     */
+    void bind(std::unique_ptr<phosphor::led::SysfsLed> led);
+
+    /** @brief Whether the sysfs device of the LED is attached */
+    bool isBound() const
+    {
+        return led != nullptr;
+    }
+
+    /** @brief sysfs path of the device providing the LED, empty while
+     *   unbound
+     */
+    fs::path getDevice() const
+    {
+        return led ? led->getDevice() : fs::path();
+    }
+
+    /** @brief Restarts the timer of a blinking LED
+     *
+     *  LEDs restarted back to back blink in phase.
+     */
+    void syncBlink();
+
     /** @brief Overloaded State Property Setter function
+     *
+     *  With an arbiter, State set directly is the request of the lowest
+     *  priority and the LED keeps the State of any other request.
      *
      *  @param[in] value   -  One of OFF / ON / BLINK
      *  @return            -  Success or exception thrown
      */
     Action state(Action value) override;
 
+    /** @brief Sets State regardless of the requests of the arbiter
+     *
+     *  @param[in] value   -  One of OFF / ON / BLINK
+     *  @return            -  Success or exception thrown
+     */
+    Action setState(Action value);
+
     /** @brief Overridden State Property Getter function
      *
      *  @return  -  One of OFF / ON / BLINK
      */
     Action state() const override;
 
+    using sdbusplus::xyz::openbmc_project::Led::server::Physical::dutyOn;
+    using sdbusplus::xyz::openbmc_project::Led::server::Physical::period;
+
+    /** @brief Overloaded DutyOn Property Setter function
+     *
+     *  @param[in] value   -  Percentage of the period the LED is on
+     *  @return            -  The new value
+     */
+    uint8_t dutyOn(uint8_t value) override;
+
+    /** @brief Overloaded Period Property Setter function
+     *
+     *  @param[in] value   -  Blink period in milliseconds
+     *  @return            -  The new value
+     */
+    uint16_t period(uint16_t value) override;
+
+    /** @brief Callback invoked after a property of the LED changed */
+    using ChangeCallback = std::function<void()>;
+
+    /** @brief Registers a callback to be invoked on property changes
+     *
+     *  @param[in] callback - the callback
+     */
+    void onChange(ChangeCallback callback);
+
+    /** @brief Hands the LED over to a kernel trigger
+     *
+     *  The kernel then drives the LED without any userspace involvement,
+     *  until the State property is set again.
+     *
+     *  @param[in] trigger - one of the available triggers
+     *  @param[in] params  - trigger attributes to set
+     */
+    void setTrigger(const std::string& trigger, const TriggerParams& params);
+
+    /** @brief Triggers supported by the LED, read once it is bound */
+    const std::vector<std::string>& getTriggers() const
+    {
+        return triggers->getNames();
+    }
+
+    /** @brief The trigger currently driving the LED */
+    const std::string& getTrigger() const
+    {
+        return activeTrigger;
+    }
+
+    /** @brief Attributes of the current trigger set by setTrigger */
+    const TriggerParams& getTriggerParams() const
+    {
+        return triggerParams;
+    }
+
+    /** @brief Whether the sequencer or the frame scheduler plays on the
+     *   LED, what they play can not be read back
+     */
+    bool isPlaying() const
+    {
+        return (sequencer != nullptr && sequencer->isActive(this)) ||
+               (frames != nullptr && frames->isActive(this));
+    }
+
+    /** @brief Sets the sequencer playing patterns the kernel cannot
+     *
+     *  @param[in] sequencer - the sequencer shared by all LEDs
+     */
+    void setSequencer(Sequencer* sequencer)
+    {
+        this->sequencer = sequencer;
+    }
+
+    /** @brief Sets the arbiter State set directly goes through
+     *
+     *  @param[in] arbiter - the arbiter shared by all LEDs
+     */
+    void setArbiter(Arbiter* arbiter)
+    {
+        this->arbiter = arbiter;
+    }
+
+    /** @brief Sets the limiter of State writes to the backing device
+     *
+     *  Only State writes changing the LED take a token. DutyOn, Period,
+     *  triggers, patterns, pulses, the level, the color and corrections
+     *  of the scrubber are written right away.
+     *
+     *  @param[in] limiter - the limiter shared by all LEDs
+     */
+    void setRateLimiter(RateLimiter* limiter)
+    {
+        this->limiter = limiter;
+    }
+
+    /** @brief Sets the scheduler retrying failed State writes
+     *
+     *  @param[in] retrier - the scheduler shared by all LEDs
+     */
+    void setRetryScheduler(RetryScheduler* retrier)
+    {
+        this->retrier = retrier;
+    }
+
+    /** @brief Sets the monitor the duration of State writes is reported to
+     *
+     *  @param[in] monitor - the monitor shared by all LEDs
+     */
+    void setLagMonitor(LagMonitor* monitor)
+    {
+        this->monitor = monitor;
+    }
+
+    /** @brief Sets the queue State writes go through while it batches
+     *
+     *  @param[in] queue - the queue shared by all LEDs
+     */
+    void setWriteQueue(WriteQueue* queue)
+    {
+        writeQueue = queue;
+    }
+
+    /** @brief Number of failed attempts to write a State */
+    uint64_t getFailedWrites() const
+    {
+        return failedWrites;
+    }
+
+    /** @brief Number of State writes given up on, State was rolled back */
+    uint64_t getAbandonedWrites() const
+    {
+        return abandonedWrites;
+    }
+
+    /** @brief Number of State writes deferred by the rate limit */
+    uint64_t getDeferredWrites() const
+    {
+        return deferredWrites;
+    }
+
+    /** @brief Number of State writes merged into a deferred one */
+    uint64_t getMergedWrites() const
+    {
+        return mergedWrites;
+    }
+
+    /** @brief Sets the scheduler stepping fades the kernel cannot
+     *
+     *  @param[in] frames - the frame scheduler shared by all LEDs
+     */
+    void setFrameScheduler(FrameScheduler* frames)
+    {
+        this->frames = frames;
+    }
+
+    /** @brief Watches for brightness changes made by the hardware
+     *
+     *  Only LEDs exposing brightness_hw_changed are watched. The kernel
+     *  wakes the event loop on a change, nothing is polled.
+     *
+     *  @param[in] event - event loop to watch on
+     */
+    void watchHardware(const sdeventplus::Event& event);
+
+    /** @brief Updates State after the hardware changed the brightness */
+    void hardwareChanged();
+
+    /** @brief Compares an LED to its State and corrects drift
+     *
+     *  LEDs the hardware may change get State updated if they were turned
+     *  on or off, all others are set back to State. Blinking and triggered
+     *  LEDs are checked for their trigger, blinking ones also for their
+     *  delays.
+     *
+     *  @return true if the LED had drifted
+     */
+    bool scrub();
+
+    /** @brief Duration in milliseconds of turning the LED on */
+    uint16_t getFadeIn() const
+    {
+        return fadeIn;
+    }
+
+    /** @brief Duration in milliseconds of turning the LED off */
+    uint16_t getFadeOut() const
+    {
+        return fadeOut;
+    }
+
+    /** @brief Sets the duration of turning the LED on
+     *
+     *  @param[in] value - duration in milliseconds, 0 switches instantly
+     */
+    void setFadeIn(uint16_t value);
+
+    /** @brief Sets the duration of turning the LED off
+     *
+     *  @param[in] value - duration in milliseconds, 0 switches instantly
+     */
+    void setFadeOut(uint16_t value);
+
+    /** @brief Plays a blink pattern
+     *
+     *  The pattern is handed to the kernel pattern trigger in a single
+     *  write if the LED supports it, otherwise it is played by the
+     *  sequencer. Setting State or stopPattern() ends it.
+     *
+     *  @param[in] pattern - steps of brightness in percent and duration
+     *  @param[in] repeat  - number of cycles or repeatForever
+     */
+    void setPattern(const Pattern& pattern, int32_t repeat);
+
+    /** @brief Stops a pattern and returns the LED to its State */
+    void stopPattern();
+
+    /** @brief Multicolor channels, nullptr for single color LEDs */
+    const MultiColor* getMultiColor() const
+    {
+        return multicolor.get();
+    }
+
+    /** @brief Sets the channel intensities of a multicolor LED
+     *
+     *  @param[in] intensity - one value per channel, up to max_brightness
+     */
+    void setIntensity(const std::vector<unsigned long>& intensity);
+
+    /** @brief Sets the color of a multicolor LED
+     *
+     *  The red, green and blue components are mapped to the channels and
+     *  written with a single multi_intensity write.
+     *
+     *  @param[in] red   - red component
+     *  @param[in] green - green component
+     *  @param[in] blue  - blue component
+     */
+    void setColor(uint8_t red, uint8_t green, uint8_t blue);
+
+    /** @brief Flips a steady LED for the given time
+     *
+     *  Uses the kernel oneshot or transient trigger if available, so
+     *  every pulse after the first is a single write, and the sequencer
+     *  otherwise. Pulses arriving during a pulse are coalesced.
+     *
+     *  @param[in] duration - duration of the pulse in milliseconds
+     */
+    void pulse(uint16_t duration);
+
+    /** @brief Brightness of the lit LED in percent */
+    uint8_t getLevel() const
+    {
+        return level;
+    }
+
+    /** @brief Dims the LED
+     *
+     *  The level is perceptually linear and applies to the On state,
+     *  blinking and patterns alike. A steady or blinking LED is updated
+     *  right away.
+     *
+     *  @param[in] value - brightness in percent, 1 to 100
+     */
+    void setLevel(uint8_t value);
+
   private:
     /** @brief Associated LED implementation
      */
     std::unique_ptr<phosphor::led::SysfsLed> led;
 
+
     /** @brief The value that will assert the LED */
     unsigned long assert{};
 
+    /** @brief Brightness values by level, shared by LEDs of the same
+     *   max_brightness
+     */
+    const BrightnessTable* levels = nullptr;
+
+    /** @brief Brightness of the lit LED in percent */
+    uint8_t level = maxLevel;
+
+    /** @brief Triggers supported by the LED, shared by all LEDs with the
+     *   same list
+     */
+    const TriggerSet* triggers = nullptr;
+
+    /** @brief The trigger currently driving the LED */
+    std::string activeTrigger;
+
+    /** @brief Attributes of the current trigger */
+    TriggerParams triggerParams;
+
+    /** @brief Channels of a multicolor LED */
+    std::unique_ptr<MultiColor> multicolor;
+
+    /** @brief Sequencer for patterns the kernel cannot play */
+    Sequencer* sequencer = nullptr;
+
+    /** @brief Scheduler for fades the kernel cannot play */
+    FrameScheduler* frames = nullptr;
+
+    /** @brief Arbiter of the State requests of clients */
+    Arbiter* arbiter = nullptr;
+
+    /** @brief Limiter of State writes to the backing device */
+    RateLimiter* limiter = nullptr;
+
+    /** @brief State the LED shows while a State write is deferred */
+    std::optional<Action> deferredFrom;
+
+    /** @brief Number of State writes deferred by the rate limit */
+    uint64_t deferredWrites = 0;
+
+    /** @brief Number of State writes merged into a deferred one */
+    uint64_t mergedWrites = 0;
+
+    /** @brief Scheduler retrying failed State writes */
+    RetryScheduler* retrier = nullptr;
+
+    /** @brief Monitor of the time State writes block the loop */
+    LagMonitor* monitor = nullptr;
+
+    /** @brief Queue batching the State writes of many LEDs */
+    WriteQueue* writeQueue = nullptr;
+
+    /** @brief Backend collecting the writes for writeQueue, set while
+     *  a State is queued
+     */
+    QueuedSysfsLed* queued = nullptr;
+
+    /** @brief State before the first of the States queued meanwhile */
+    Action queuedFrom = Action::Off;
+
+    /** @brief Number of States queued, identifies the latest callback */
+    uint64_t queueGeneration = 0;
+
+    /** @brief Number of failed attempts to write a State */
+    uint64_t failedWrites = 0;
+
+    /** @brief Number of State writes given up on */
+    uint64_t abandonedWrites = 0;
+
+    /** @brief Duration in milliseconds of turning the LED on */
+    uint16_t fadeIn = 0;
+
+    /** @brief Duration in milliseconds of turning the LED off */
+    uint16_t fadeOut = 0;
+
+    /** @brief The sequencer plays a pulse */
+    bool pulsing = false;
+
+    /** @brief The kernel pattern trigger plays, or has played, a fade */
+    bool kernelFade = false;
+
+    /** @brief Bind keeps what the LED shows rather than applying State */
+    bool adoptHardware = false;
+
+    /** @brief The driver rounds the blink delays, they are not scrubbed */
+    bool roundedDelays = false;
+
+    /** @brief Callbacks invoked on property changes */
+    std::vector<ChangeCallback> changeCallbacks;
+
+    /** @brief Watch of brightness_hw_changed, released before the LED */
+    std::optional<sdeventplus::source::IO> hardwareWatch;
+
+    /** @brief Invokes the registered change callbacks */
+    void notifyChange();
+
     /** @brief reads sysfs and then setup the parameters accordingly
      *
      *  @return None
      */
     void setInitialState();
 
+    /** @brief reads the brightness range and the triggers of the LED
+     *
+     *  @return None
+     */
+    void setCapabilities();
+
+    /** @brief reads the channels of a multicolor LED
+     *
+     *  @return None
+     */
+    void setInitialColor();
+
+    /** @brief Writes State to the LED, retrying transient errors
+     *
+     *  Once out of retries, or on an error retrying does not help, State
+     *  is rolled back to the one the write started from.
+     *
+     *  @param [in] from    - State of the LED before the write
+     *  @param [in] attempt - number of retries run so far
+     */
+    void writeState(Action from, unsigned attempt);
+
+    /** @brief Retries or rolls back a failed State write
+     *
+     *  @param [in] from    - State of the LED before the write
+     *  @param [in] attempt - number of retries run so far
+     *  @param [in] rc      - -errno of the failed write
+     */
+    void writeFailed(Action from, unsigned attempt, int rc);
+
+    /** @brief Drives the LED back to State after a failed write, e.g.
+     *  from a trigger selected without its attributes
+     */
+    void restoreState();
+
+    /** @brief Runs a write sequence on the backend of the LED, the
+     *  queued one while a State is queued
+     *
+     *  @param [in] write - the sequence, called with the backend
+     *  @return 0 on success, -errno of the first failed write
+     */
+    template <typename Write>
+    int writeBackend(Write&& write);
+
     /** @brief Applies the user triggered action on the LED
      *   by writing to sysfs
      *
      *  @param [in] current - Current state of LED
      *  @param [in] request - Requested state
      *
-     *  @return None
+     *  @return 0 on success, -errno of the first failed write
      */
-    void driveLED(Action current, Action request);
+    int driveLED(Action current, Action request);
+
+    /** @brief Whether the LED shows a State without writing it
+     *
+     *  @param [in] current - Current state of LED
+     *  @param [in] request - Requested state
+     */
+    bool isApplied(Action current, Action request) const;
 
     /** @brief Sets the LED to either ON or OFF state
      *
      *  @param [in] action - Requested action. Could be OFF or ON
-     *  @return None
+     *  @return 0 on success, -errno of the first failed write
+     */
+    int stableStateOperation(Action action);
+
+    /** @brief Fades the LED between two levels
+     *
+     *  @param [in] from     - level in percent the fade starts at
+     *  @param [in] to       - level in percent the fade ends at
+     *  @param [in] duration - duration in milliseconds
+     *  @return 0 on success, -errno of the first failed write
+     */
+    int fadeOperation(uint8_t from, uint8_t to, uint16_t duration);
+
+    /** @brief Stops patterns, pulses, fades, deferred and retried State
+     *   writes for the LED
      */
-    void stableStateOperation(Action action);
+    void stopPlayback();
 
     /** @brief Sets the LED to BLINKING
      *
-     *  @return None
+     *  @return 0 on success, -errno of the first failed write
+     */
+    int blinkOperation();
+
+    /** @brief Delays on and off in milliseconds of DutyOn and Period */
+    std::pair<unsigned long, unsigned long> blinkDelays() const;
+
+    /** @brief Compares a triggered LED to its trigger and corrects drift
+     *
+     *  @return true if the LED had drifted
+     */
+    bool scrubTrigger();
+
+    /** @brief Selects a trigger and writes its attributes
+     *
+     *  @param[in] trigger - the trigger
+     *  @param[in] params  - trigger attributes to set
+     *  @return 0 on success, -errno of the first failed write
+     */
+    int applyTrigger(const std::string& trigger, const TriggerParams& params);
+
+    /** @brief Converts a brightness in percent to the sysfs value
+     *
+     *  The brightness is scaled by the level of the LED and then mapped
+     *  through its gamma table.
+     *
+     *  @param[in] percent - brightness in percent of the maximum
      */
-    void blinkOperation();
+    unsigned long toBrightness(uint8_t percent) const;
 
     /** @brief set led color property in DBus
      *
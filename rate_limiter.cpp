@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "rate_limiter.hpp"
+
+#include <algorithm>
+#include <optional>
+
+namespace phosphor
+{
+namespace led
+{
+
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+
+RateLimiter::RateLimiter(const sdeventplus::Event& event, unsigned rate,
+                         unsigned burst) :
+    clock(event), timer(event, [this](auto&) { tick(); })
+{
+    timer.setEnabled(false);
+    setLimit(rate, burst);
+}
+
+void RateLimiter::setLimit(unsigned rate, unsigned burst)
+{
+    interval = rate == 0
+                   ? Clock::duration::zero()
+                   : duration_cast<microseconds>(std::chrono::seconds(1)) /
+                         rate;
+    capacity = interval * std::max(burst, 1U);
+}
+
+void RateLimiter::add(const void* owner, const std::filesystem::path& device)
+{
+    remove(owner);
+
+    if (device.empty() || interval == Clock::duration::zero())
+    {
+        return;
+    }
+
+    owners.emplace(owner, &buckets[device]);
+}
+
+void RateLimiter::remove(const void* owner)
+{
+    cancel(owner);
+    owners.erase(owner);
+}
+
+bool RateLimiter::acquire(const void* owner)
+{
+    auto it = owners.find(owner);
+    if (it == owners.end())
+    {
+        return true;
+    }
+
+    // Deferred writes go first
+    auto& bucket = *it->second;
+    return bucket.waiting.empty() && take(bucket, clock.now());
+}
+
+void RateLimiter::defer(const void* owner, Apply apply)
+{
+    auto it = owners.find(owner);
+    if (it == owners.end())
+    {
+        apply();
+        return;
+    }
+
+    auto [entry, inserted] = pending.insert_or_assign(owner, std::move(apply));
+    if (inserted)
+    {
+        it->second->waiting.emplace_back(owner);
+    }
+
+    schedule();
+}
+
+void RateLimiter::cancel(const void* owner)
+{
+    if (pending.erase(owner) == 0U)
+    {
+        return;
+    }
+
+    std::erase(owners.at(owner)->waiting, owner);
+    schedule();
+}
+
+bool RateLimiter::take(Bucket& bucket, Clock::time_point now) const
+{
+    auto full = std::max(bucket.full, now) + interval;
+    if (full - now > capacity)
+    {
+        return false;
+    }
+
+    bucket.full = full;
+    return true;
+}
+
+void RateLimiter::tick()
+{
+    auto now = clock.now();
+
+    for (auto& [device, bucket] : buckets)
+    {
+        while (!bucket.waiting.empty() && take(bucket, now))
+        {
+            auto* owner = bucket.waiting.front();
+            bucket.waiting.pop_front();
+
+            auto node = pending.extract(owner);
+            node.mapped()();
+        }
+    }
+
+    schedule();
+}
+
+void RateLimiter::schedule()
+{
+    std::optional<Clock::time_point> next;
+    for (const auto& [device, bucket] : buckets)
+    {
+        if (bucket.waiting.empty())
+        {
+            continue;
+        }
+
+        // A token is earned once the bucket drained below its capacity
+        auto due = bucket.full + interval - capacity;
+        next = next ? std::min(*next, due) : due;
+    }
+
+    if (!next)
+    {
+        timer.setEnabled(false);
+        return;
+    }
+
+    auto now = clock.now();
+    timer.restartOnce(*next > now ? *next - now : Clock::duration::zero());
+}
+
+} // namespace led
+} // namespace phosphor
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <map>
+
+namespace phosphor
+{
+namespace led
+{
+
+/** @class RateLimiter
+ *  @brief Limits the rate of LED writes per backing device
+ *
+ *  LEDs behind a shared bus, e.g. an SMBus expander, compete with sensor
+ *  polling for the bus. Each device gets a token bucket of rate writes per
+ *  second, bursts of up to burst writes pass at once. A write over budget
+ *  is deferred until a token is available; deferred writes of a device are
+ *  applied in the order they were deferred. The LEDs only limit their
+ *  State writes, see Physical::setRateLimiter().
+ */
+class RateLimiter
+{
+  public:
+    RateLimiter() = delete;
+    ~RateLimiter() = default;
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+    RateLimiter(RateLimiter&&) = delete;
+    RateLimiter& operator=(RateLimiter&&) = delete;
+
+    /** @brief Applies a deferred write */
+    using Apply = std::function<void()>;
+
+    /** @brief Constructs the limiter
+     *
+     *  @param[in] event - event loop to run the timer on
+     *  @param[in] rate  - writes per second and device, 0 for no limit
+     *  @param[in] burst - writes passing at once
+     */
+    RateLimiter(const sdeventplus::Event& event, unsigned rate,
+                unsigned burst);
+
+    /** @brief Changes the limit, owners already added keep their bucket
+     *
+     *  @param[in] rate  - writes per second and device, 0 for no limit
+     *  @param[in] burst - writes passing at once
+     */
+    void setLimit(unsigned rate, unsigned burst);
+
+    /** @brief Assigns an owner to the bucket of its device
+     *
+     *  Owners without a device are not limited.
+     *
+     *  @param[in] owner  - the owner, e.g. an LED
+     *  @param[in] device - sysfs path of the backing device
+     */
+    void add(const void* owner, const std::filesystem::path& device);
+
+    /** @brief Drops the owner and its deferred write
+     *
+     *  @param[in] owner - the owner
+     */
+    void remove(const void* owner);
+
+    /** @brief Takes a token for a write of the owner
+     *
+     *  @param[in] owner - the owner
+     *  @return true if the write may go ahead now
+     */
+    bool acquire(const void* owner);
+
+    /** @brief Applies a write once a token is available
+     *
+     *  A write deferred before replaces the earlier one, last value wins.
+     *
+     *  @param[in] owner - the owner
+     *  @param[in] apply - applies the write
+     */
+    void defer(const void* owner, Apply apply);
+
+    /** @brief Drops the deferred write of the owner
+     *
+     *  @param[in] owner - the owner
+     */
+    void cancel(const void* owner);
+
+    /** @brief Whether the owner has a deferred write
+     *
+     *  @param[in] owner - the owner
+     */
+    bool isDeferred(const void* owner) const
+    {
+        return pending.contains(owner);
+    }
+
+  private:
+    using Clock = sdeventplus::Clock<sdeventplus::ClockId::Monotonic>;
+
+    /** @brief Token bucket of one device */
+    struct Bucket
+    {
+        /** @brief Time the bucket is full again */
+        Clock::time_point full;
+
+        /** @brief Owners with a deferred write, in order */
+        std::deque<const void*> waiting;
+    };
+
+    /** @brief Clock of the event loop */
+    Clock clock;
+
+    /** @brief Timer applying deferred writes */
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> timer;
+
+    /** @brief Time it takes to earn a token */
+    Clock::duration interval;
+
+    /** @brief Time worth of tokens a bucket holds */
+    Clock::duration capacity;
+
+    /** @brief Buckets by device */
+    std::map<std::filesystem::path, Bucket> buckets;
+
+    /** @brief Bucket of each limited owner */
+    std::map<const void*, Bucket*> owners;
+
+    /** @brief Deferred writes by owner */
+    std::map<const void*, Apply> pending;
+
+    /** @brief Takes a token from a bucket
+     *
+     *  @param[in] bucket - the bucket
+     *  @param[in] now    - current time
+     *  @return false if the bucket is empty
+     */
+    bool take(Bucket& bucket, Clock::time_point now) const;
+
+    /** @brief Applies the deferred writes tokens are available for */
+    void tick();
+
+    /** @brief Arms the timer for the next token a write waits for */
+    void schedule();
+};
+
+} // namespace led
+} // namespace phosphor
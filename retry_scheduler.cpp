@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "retry_scheduler.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <vector>
+
+namespace phosphor
+{
+namespace led
+{
+
+RetryScheduler::RetryScheduler(const sdeventplus::Event& event) :
+    clock(event), timer(event, [this](auto&) { tick(); })
+{
+    timer.setEnabled(false);
+}
+
+bool RetryScheduler::retry(const void* owner, unsigned attempt, Apply apply)
+{
+    if (attempt >= maxRetries)
+    {
+        cancel(owner);
+        return false;
+    }
+
+    auto due = clock.now() + baseDelay * (1U << attempt);
+    entries.insert_or_assign(owner, Entry{std::move(apply), due});
+    schedule();
+
+    return true;
+}
+
+void RetryScheduler::cancel(const void* owner)
+{
+    if (entries.erase(owner) != 0U)
+    {
+        schedule();
+    }
+}
+
+bool RetryScheduler::isTransient(int rc)
+{
+    // Bus errors of I2C and SMBus devices, and drivers asking to come back
+    switch (-rc)
+    {
+        case EAGAIN:
+        case EBUSY:
+        case EIO:
+        case ENXIO:
+        case EREMOTEIO:
+        case ETIMEDOUT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void RetryScheduler::tick()
+{
+    auto now = clock.now();
+
+    // A retry may schedule the next one of its owner
+    std::vector<Apply> due;
+    for (auto it = entries.begin(); it != entries.end();)
+    {
+        if (it->second.due <= now)
+        {
+            due.emplace_back(std::move(it->second.apply));
+            it = entries.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    for (auto& apply : due)
+    {
+        apply();
+    }
+
+    schedule();
+}
+
+void RetryScheduler::schedule()
+{
+    if (entries.empty())
+    {
+        timer.setEnabled(false);
+        return;
+    }
+
+    auto next = std::ranges::min_element(entries, {}, [](const auto& entry) {
+                    return entry.second.due;
+                })->second.due;
+
+    auto now = clock.now();
+    timer.restartOnce(next > now ? next - now : Clock::duration::zero());
+}
+
+} // namespace led
+} // namespace phosphor
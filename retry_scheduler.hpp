@@ -0,0 +1,111 @@
+#pragma once
+
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <chrono>
+#include <functional>
+#include <map>
+
+namespace phosphor
+{
+namespace led
+{
+
+/** @class RetryScheduler
+ *  @brief Retries failed LED writes with an exponential backoff
+ *
+ *  A device NACKing on its bus often answers again a few milliseconds
+ *  later. Retries run from a single timer on the event loop, the n-th
+ *  retry of a write waits baseDelay * 2^n. A write is retried maxRetries
+ *  times at most, so a flaky device costs the loop a bounded number of
+ *  writes and never blocks it.
+ */
+class RetryScheduler
+{
+  public:
+    RetryScheduler() = delete;
+    ~RetryScheduler() = default;
+    RetryScheduler(const RetryScheduler&) = delete;
+    RetryScheduler& operator=(const RetryScheduler&) = delete;
+    RetryScheduler(RetryScheduler&&) = delete;
+    RetryScheduler& operator=(RetryScheduler&&) = delete;
+
+    /** @brief Retries a write */
+    using Apply = std::function<void()>;
+
+    /** @brief Constructs the scheduler
+     *
+     *  @param[in] event - event loop to run the timer on
+     */
+    explicit RetryScheduler(const sdeventplus::Event& event);
+
+    /** @brief Schedules a retry of a failed write
+     *
+     *  A retry scheduled before for the owner is replaced.
+     *
+     *  @param[in] owner   - the owner, e.g. an LED
+     *  @param[in] attempt - number of retries run so far
+     *  @param[in] apply   - retries the write
+     *  @return false if the write is out of retries
+     */
+    bool retry(const void* owner, unsigned attempt, Apply apply);
+
+    /** @brief Drops the retry of the owner
+     *
+     *  @param[in] owner - the owner
+     */
+    void cancel(const void* owner);
+
+    /** @brief Whether the owner has a retry scheduled
+     *
+     *  @param[in] owner - the owner
+     */
+    bool isPending(const void* owner) const
+    {
+        return entries.contains(owner);
+    }
+
+    /** @brief Whether an error may go away by retrying
+     *
+     *  @param[in] rc - the -errno of the failed write
+     */
+    static bool isTransient(int rc);
+
+    /** @brief Delay of the first retry */
+    static constexpr std::chrono::milliseconds baseDelay{20};
+
+    /** @brief Retries of a write, the last one runs 300ms after it failed */
+    static constexpr unsigned maxRetries = 4;
+
+  private:
+    using Clock = sdeventplus::Clock<sdeventplus::ClockId::Monotonic>;
+
+    /** @brief A scheduled retry */
+    struct Entry
+    {
+        Apply apply;
+
+        /** @brief When the retry is due */
+        Clock::time_point due;
+    };
+
+    /** @brief Clock of the event loop */
+    Clock clock;
+
+    /** @brief Timer running the retries */
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> timer;
+
+    /** @brief Retries by owner */
+    std::map<const void*, Entry> entries;
+
+    /** @brief Runs the retries that are due */
+    void tick();
+
+    /** @brief Arms the timer for the next retry, or disables it */
+    void schedule();
+};
+
+} // namespace led
+} // namespace phosphor
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "scrubber.hpp"
+
+#include <systemd/sd-event.h>
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+namespace phosphor
+{
+namespace led
+{
+
+Scrubber::Scrubber(const sdeventplus::Event& event, unsigned budget,
+                   std::chrono::milliseconds interval) :
+    clock(event),
+    timer(event, clock.now(), std::chrono::seconds(1),
+          [this](auto&, auto) { tick(); }),
+    budget(std::max(budget, 1U)), shortest(interval),
+    longest(interval * (maxInterval / minInterval))
+{
+    // Requests and fades always go first
+    timer.set_priority(SD_EVENT_PRIORITY_IDLE);
+    timer.set_enabled(sdeventplus::source::Enabled::Off);
+}
+
+void Scrubber::add(const void* owner, Check check)
+{
+    auto now = clock.now();
+    entries.insert_or_assign(owner,
+                             Entry{std::move(check), shortest, now + shortest});
+    schedule();
+}
+
+void Scrubber::remove(const void* owner)
+{
+    if (entries.erase(owner) != 0U)
+    {
+        schedule();
+    }
+}
+
+void Scrubber::tick()
+{
+    auto now = clock.now();
+    last = now;
+
+    std::vector<Entry*> due;
+    for (auto& [owner, entry] : entries)
+    {
+        if (entry.next <= now)
+        {
+            due.emplace_back(&entry);
+        }
+    }
+
+    // The most overdue LEDs first, the others wait for the next tick
+    auto count = std::min<size_t>(due.size(), budget);
+    std::ranges::partial_sort(due, due.begin() + count, {},
+                              [](const Entry* entry) { return entry->next; });
+
+    for (auto* entry : std::span(due).first(count))
+    {
+        if (entry->check())
+        {
+            entry->interval = shortest;
+        }
+        else
+        {
+            entry->interval = std::min(entry->interval * 2, longest);
+        }
+        entry->next = now + entry->interval;
+    }
+
+    schedule();
+}
+
+void Scrubber::schedule()
+{
+    if (entries.empty())
+    {
+        timer.set_enabled(sdeventplus::source::Enabled::Off);
+        return;
+    }
+
+    auto next = std::ranges::min_element(entries, {}, [](const auto& entry) {
+                    return entry.second.next;
+                })->second.next;
+
+    // Keep the ticks, and so the reads, within the budget per second
+    next = std::max<Clock::time_point>(next, last + std::chrono::seconds(1));
+
+    timer.set_time(next);
+    timer.set_enabled(sdeventplus::source::Enabled::OneShot);
+}
+
+} // namespace led
+} // namespace phosphor
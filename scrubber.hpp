@@ -0,0 +1,120 @@
+#pragma once
+
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/time.hpp>
+
+#include <chrono>
+#include <functional>
+#include <map>
+
+namespace phosphor
+{
+namespace led
+{
+
+/** @class Scrubber
+ *  @brief Periodically verifies that LEDs still show their published state
+ *
+ *  Other tools or a driver reset may change an LED behind our back. Each
+ *  LED is checked at its own interval, which is reset to minInterval
+ *  after a drift and doubles up to maxInterval while the LED is stable.
+ *  At most budget LEDs are checked per second, and the timer runs at idle
+ *  priority, so scrubbing never delays requests.
+ */
+class Scrubber
+{
+  public:
+    Scrubber() = delete;
+    ~Scrubber() = default;
+    Scrubber(const Scrubber&) = delete;
+    Scrubber& operator=(const Scrubber&) = delete;
+    Scrubber(Scrubber&&) = delete;
+    Scrubber& operator=(Scrubber&&) = delete;
+
+    /** @brief Checks an LED, returns true if it had drifted */
+    using Check = std::function<bool()>;
+
+    /** @brief Constructs the scrubber
+     *
+     *  @param[in] event    - event loop to run the timer on
+     *  @param[in] budget   - LEDs checked per second at most
+     *  @param[in] interval - interval of LEDs that drifted recently, the
+     *                        longest one is maxInterval / minInterval
+     *                        times that
+     */
+    explicit Scrubber(const sdeventplus::Event& event,
+                      unsigned budget = defaultBudget,
+                      std::chrono::milliseconds interval = minInterval);
+
+    /** @brief Starts checking an LED
+     *
+     *  @param[in] owner - identifies the LED
+     *  @param[in] check - callback comparing the LED to its state
+     */
+    void add(const void* owner, Check check);
+
+    /** @brief Stops checking an LED
+     *
+     *  @param[in] owner - identifies the LED
+     */
+    void remove(const void* owner);
+
+    /** @brief Default budget, LED checks per second
+     *
+     *  The budget counts checks, not attribute accesses. A check reads
+     *  one to three attributes, and writes the LED if it had drifted.
+     */
+    static constexpr unsigned defaultBudget = 4;
+
+    /** @brief Interval of LEDs that drifted recently */
+    static constexpr std::chrono::seconds minInterval{10};
+
+    /** @brief Interval of LEDs that have been stable for a while */
+    static constexpr std::chrono::seconds maxInterval{640};
+
+  private:
+    using Clock = sdeventplus::Clock<sdeventplus::ClockId::Monotonic>;
+
+    /** @brief Schedule of one LED */
+    struct Entry
+    {
+        Check check;
+
+        /** @brief Current check interval */
+        Clock::duration interval;
+
+        /** @brief When the LED is due */
+        Clock::time_point next;
+    };
+
+    /** @brief Clock of the event loop */
+    Clock clock;
+
+    /** @brief Idle priority timer, disabled without LEDs */
+    sdeventplus::source::Time<sdeventplus::ClockId::Monotonic> timer;
+
+    /** @brief LEDs checked per tick, ticks are a second apart at least */
+    unsigned budget;
+
+    /** @brief Interval of LEDs that drifted recently */
+    Clock::duration shortest;
+
+    /** @brief Interval of LEDs that have been stable for a while */
+    Clock::duration longest;
+
+    /** @brief LEDs by owner */
+    std::map<const void*, Entry> entries;
+
+    /** @brief When the last tick ran */
+    Clock::time_point last;
+
+    /** @brief Checks the most overdue LEDs within the budget */
+    void tick();
+
+    /** @brief Arms the timer for the next due LED, or disables it */
+    void schedule();
+};
+
+} // namespace led
+} // namespace phosphor
@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "sequencer.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+
+namespace phosphor
+{
+namespace led
+{
+
+Sequencer::Sequencer(const sdeventplus::Event& event) :
+    clock(event), timer(event, [this](auto&) { tick(); })
+{
+    timer.setEnabled(false);
+}
+
+void Sequencer::start(const void* owner, Pattern pattern, int32_t repeat,
+                      Apply apply)
+{
+    auto cycle = std::accumulate(
+        pattern.begin(), pattern.end(), std::chrono::milliseconds(0),
+        [](auto sum, const PatternStep& step) {
+            return sum + std::chrono::milliseconds(step.duration);
+        });
+
+    auto now = clock.now();
+    auto& seq = sequences.insert_or_assign(
+                             owner, Sequence{std::move(pattern), repeat,
+                                             std::move(apply), cycle, 0, now})
+                    .first->second;
+
+    if (!advance(seq, now))
+    {
+        sequences.erase(owner);
+    }
+
+    schedule();
+}
+
+void Sequencer::stop(const void* owner)
+{
+    if (sequences.erase(owner) != 0U)
+    {
+        schedule();
+    }
+}
+
+bool Sequencer::advance(Sequence& seq, Clock::time_point now)
+{
+    // Do not replay every missed step after the loop was stalled
+    if (now - seq.next > seq.cycle)
+    {
+        seq.next = now;
+    }
+
+    while (seq.next <= now)
+    {
+        if (seq.index == seq.pattern.size())
+        {
+            if (seq.repeat != repeatForever && --seq.repeat <= 0)
+            {
+                return false;
+            }
+            seq.index = 0;
+        }
+
+        const auto& step = seq.pattern[seq.index++];
+        seq.apply(step.brightness);
+        seq.next += std::chrono::milliseconds(step.duration);
+    }
+
+    return true;
+}
+
+void Sequencer::tick()
+{
+    auto now = clock.now();
+
+    for (auto it = sequences.begin(); it != sequences.end();)
+    {
+        it = advance(it->second, now) ? std::next(it) : sequences.erase(it);
+    }
+
+    schedule();
+}
+
+void Sequencer::schedule()
+{
+    if (sequences.empty())
+    {
+        timer.setEnabled(false);
+        return;
+    }
+
+    auto next = std::ranges::min_element(sequences, {}, [](const auto& entry) {
+                    return entry.second.next;
+                })->second.next;
+
+    auto now = clock.now();
+    timer.restartOnce(next > now ? next - now : Clock::duration::zero());
+}
+
+} // namespace led
+} // namespace phosphor
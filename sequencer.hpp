@@ -0,0 +1,130 @@
+#pragma once
+
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace phosphor
+{
+namespace led
+{
+
+/** @brief One step of a blink pattern */
+struct PatternStep
+{
+    /** @brief Brightness in percent of the maximum */
+    uint8_t brightness;
+
+    /** @brief Time in milliseconds the brightness is held */
+    uint16_t duration;
+};
+
+/** @brief Blink pattern, a sequence of steps */
+using Pattern = std::vector<PatternStep>;
+
+/** @brief Repeat count of a pattern repeated forever */
+constexpr int32_t repeatForever = -1;
+
+/** @class Sequencer
+ *  @brief Plays blink patterns of LEDs lacking the kernel pattern trigger
+ *
+ *  A single timer is shared by all LEDs. It is armed for the earliest
+ *  pending step and disabled while no pattern is playing.
+ */
+class Sequencer
+{
+  public:
+    Sequencer() = delete;
+    ~Sequencer() = default;
+    Sequencer(const Sequencer&) = delete;
+    Sequencer& operator=(const Sequencer&) = delete;
+    Sequencer(Sequencer&&) = delete;
+    Sequencer& operator=(Sequencer&&) = delete;
+
+    /** @brief Applies the brightness of a step, in percent */
+    using Apply = std::function<void(uint8_t)>;
+
+    /** @brief Constructs the sequencer
+     *
+     *  @param[in] event - event loop to run the timer on
+     */
+    explicit Sequencer(const sdeventplus::Event& event);
+
+    /** @brief Starts playing a pattern, replacing the one of the owner
+     *
+     *  @param[in] owner   - identifies the pattern, usually the LED
+     *  @param[in] pattern - steps to play, the duration of a full cycle
+     *                       must not be 0
+     *  @param[in] repeat  - number of cycles or repeatForever
+     *  @param[in] apply   - callback applying the brightness of a step
+     */
+    void start(const void* owner, Pattern pattern, int32_t repeat,
+               Apply apply);
+
+    /** @brief Stops the pattern of the owner, if any
+     *
+     *  @param[in] owner - identifies the pattern
+     */
+    void stop(const void* owner);
+
+    /** @brief Whether a pattern of the owner is playing
+     *
+     *  @param[in] owner - identifies the pattern
+     */
+    bool isActive(const void* owner) const
+    {
+        return sequences.contains(owner);
+    }
+
+  private:
+    using Clock = sdeventplus::Clock<sdeventplus::ClockId::Monotonic>;
+
+    /** @brief Playback state of one pattern */
+    struct Sequence
+    {
+        Pattern pattern;
+        int32_t repeat;
+        Apply apply;
+
+        /** @brief Duration of a full cycle */
+        std::chrono::milliseconds cycle;
+
+        /** @brief Step to apply next */
+        size_t index;
+
+        /** @brief When to apply the next step */
+        Clock::time_point next;
+    };
+
+    /** @brief Clock of the event loop */
+    Clock clock;
+
+    /** @brief Timer shared by all patterns */
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> timer;
+
+    /** @brief Playing patterns by owner */
+    std::map<const void*, Sequence> sequences;
+
+    /** @brief Applies all due steps and rearms the timer */
+    void tick();
+
+    /** @brief Applies the due steps of a pattern
+     *
+     *  @param[in] seq - the pattern
+     *  @param[in] now - current time
+     *  @return false once the pattern has finished
+     */
+    static bool advance(Sequence& seq, Clock::time_point now);
+
+    /** @brief Arms the timer for the earliest step, or disables it */
+    void schedule();
+};
+
+} // namespace led
+} // namespace phosphor
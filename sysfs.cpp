@@ -18,10 +18,19 @@
 
 #include "phosphor-logging/lg2.hpp"
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
 #include <cstring>
 #include <fstream>
 #include <optional>
+#include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace fs = std::filesystem;
@@ -49,21 +58,98 @@ unsigned long getSysfsAttr(const fs::path& path)
     return std::strtoul(content.c_str(), nullptr, 0);
 }
 
-template <typename T>
-void setSysfsAttr(const fs::path& path, const T& value)
+int setSysfsAttr(const fs::path& path, std::string_view value)
+{
+    // The attribute takes the value in a single write
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                  S_IRUSR | S_IWUSR);
+    if (fd < 0)
+    {
+        return -errno;
+    }
+
+    int rc = 0;
+    auto written = write(fd, value.data(), value.size());
+    if (written < 0)
+    {
+        rc = -errno;
+    }
+    else if (static_cast<size_t>(written) != value.size())
+    {
+        rc = -EIO;
+    }
+
+    close(fd);
+    return rc;
+}
+
+SysfsLed::~SysfsLed()
+{
+    if (brightnessFd >= 0)
+    {
+        close(brightnessFd);
+    }
+
+    if (hwChangedFd >= 0)
+    {
+        close(hwChangedFd);
+    }
+}
+
+int SysfsLed::getBrightnessFd()
 {
-    std::ofstream file(path);
-    file << value;
+    if (brightnessFd < 0)
+    {
+        brightnessFd =
+            open((root / attrBrightness).c_str(), O_RDWR | O_CLOEXEC);
+    }
+
+    return brightnessFd;
 }
 
 unsigned long SysfsLed::getBrightness()
 {
-    return getSysfsAttr<unsigned long>(root / attrBrightness);
+    int fd = getBrightnessFd();
+    if (fd < 0)
+    {
+        return 0;
+    }
+
+    // sysfs regenerates the content on every read from offset 0
+    std::array<char, 32> buffer{};
+    if (pread(fd, buffer.data(), buffer.size() - 1, 0) <= 0)
+    {
+        return 0;
+    }
+
+    return std::strtoul(buffer.data(), nullptr, 0);
 }
 
-void SysfsLed::setBrightness(unsigned long brightness)
+int SysfsLed::setBrightness(unsigned long brightness)
 {
-    setSysfsAttr<unsigned long>(root / attrBrightness, brightness);
+    int fd = getBrightnessFd();
+    if (fd < 0)
+    {
+        return -errno;
+    }
+
+    // The kernel drops the trigger when the LED is turned off
+    if (brightness == 0)
+    {
+        invalidateTrigger();
+    }
+
+    // sysfs takes the value in a single write at offset 0
+    auto content = std::to_string(brightness) + "\n";
+    if (pwrite(fd, content.data(), content.size(), 0) < 0)
+    {
+        int rc = -errno;
+        lg2::error("Unable to write brightness of {PATH}: {ERROR}", "PATH",
+                   root.string(), "ERROR", strerror(-rc));
+        return rc;
+    }
+
+    return 0;
 }
 
 unsigned long SysfsLed::getMaxBrightness()
@@ -71,6 +157,30 @@ unsigned long SysfsLed::getMaxBrightness()
     return getSysfsAttr<unsigned long>(root / attrMaxBrightness);
 }
 
+namespace
+{
+
+/** @brief Picks the active trigger, the one in brackets, from the list */
+std::string parseActiveTrigger(const std::string& triggerLine)
+{
+    size_t start = triggerLine.find_first_of('[');
+    size_t end = triggerLine.find_first_of(']');
+    if (start >= end || start == std::string::npos || end == std::string::npos)
+    {
+        return "none";
+    }
+
+    std::string rc = triggerLine.substr(start + 1, end - start - 1);
+    if (rc.empty())
+    {
+        return "none";
+    }
+
+    return rc;
+}
+
+} // namespace
+
 std::string SysfsLed::getTrigger()
 {
     // Example content for `/sys/class/leds/<led_name>/trigger`:
@@ -82,26 +192,140 @@ std::string SysfsLed::getTrigger()
     //
     // * https://git.kernel.org/pub/scm/linux/kernel/git/torvalds/linux.git/tree/Documentation/ABI/testing/sysfs-class-led?h=v6.6#n71
     // * https://git.kernel.org/pub/scm/linux/kernel/git/torvalds/linux.git/tree/Documentation/ABI/stable/sysfs-block?h=v6.6#n558
+    if (!activeTrigger)
+    {
+        activeTrigger = parseActiveTrigger(
+            getSysfsAttr<std::string>(root / attrTrigger));
+    }
+
+    return *activeTrigger;
+}
+
+std::vector<std::string> SysfsLed::getTriggers()
+{
+    // All triggers known to the kernel, the active one in brackets. The
+    // file is several KB with many network devices or disks, the active
+    // trigger is kept from the same read.
     std::string triggerLine = getSysfsAttr<std::string>(root / attrTrigger);
-    size_t start = triggerLine.find_first_of('[');
-    size_t end = triggerLine.find_first_of(']');
-    if (start >= end || start == std::string::npos || end == std::string::npos)
+    activeTrigger = parseActiveTrigger(triggerLine);
+
+    std::vector<std::string> triggers;
+    std::istringstream ss(triggerLine);
+    std::string item;
+
+    while (ss >> item)
     {
-        return "none";
+        if (item.starts_with('[') && item.ends_with(']'))
+        {
+            item = item.substr(1, item.size() - 2);
+        }
+
+        if (!item.empty())
+        {
+            triggers.emplace_back(std::move(item));
+        }
     }
 
-    std::string rc = triggerLine.substr(start + 1, end - start - 1);
-    if (rc.empty())
+    return triggers;
+}
+
+int SysfsLed::setTriggerAttr(const std::string& attr, const std::string& value)
+{
+    // Trigger specific attributes only exist while the trigger is active
+    return setSysfsAttr(root / attr, value);
+}
+
+bool SysfsLed::hasAttr(const std::string& attr)
+{
+    std::error_code ec;
+    return fs::exists(root / attr, ec);
+}
+
+std::vector<std::string> SysfsLed::getMultiIndex()
+{
+    // Channel colors of a multicolor LED, e.g. `red green blue`
+    std::istringstream ss(getSysfsAttr<std::string>(root / attrMultiIndex));
+    std::vector<std::string> channels;
+    std::string item;
+
+    while (ss >> item)
     {
-        return "none";
+        channels.emplace_back(std::move(item));
     }
 
-    return rc;
+    return channels;
+}
+
+std::vector<unsigned long> SysfsLed::getMultiIntensity()
+{
+    std::istringstream ss(
+        getSysfsAttr<std::string>(root / attrMultiIntensity));
+    std::vector<unsigned long> values;
+    unsigned long value = 0;
+
+    while (ss >> value)
+    {
+        values.emplace_back(value);
+    }
+
+    return values;
+}
+
+int SysfsLed::setMultiIntensity(const std::vector<unsigned long>& values)
+{
+    // All channels are set with a single write
+    std::string content;
+    for (auto value : values)
+    {
+        content += std::to_string(value) + " ";
+    }
+    if (!content.empty())
+    {
+        content.pop_back();
+    }
+
+    return setSysfsAttr(root / attrMultiIntensity, content);
+}
+
+int SysfsLed::setTrigger(const std::string& trigger)
+{
+    invalidateTrigger();
+    return setSysfsAttr(root / attrTrigger, trigger);
 }
 
-void SysfsLed::setTrigger(const std::string& trigger)
+int SysfsLed::getHwChangedFd()
 {
-    setSysfsAttr<std::string>(root / attrTrigger, trigger);
+    // Only LEDs the hardware can change on its own have the attribute
+    if (hwChangedFd < 0)
+    {
+        hwChangedFd = open((root / attrBrightnessHwChanged).c_str(),
+                           O_RDONLY | O_CLOEXEC);
+
+        // The attribute has to be read once before poll reports changes
+        if (hwChangedFd >= 0)
+        {
+            getBrightnessHwChanged();
+        }
+    }
+
+    return hwChangedFd;
+}
+
+std::optional<unsigned long> SysfsLed::getBrightnessHwChanged()
+{
+    if (hwChangedFd < 0)
+    {
+        return std::nullopt;
+    }
+
+    // Fails with ENODATA until the hardware changed the brightness once
+    std::array<char, 32> buffer{};
+    if (pread(hwChangedFd, buffer.data(), buffer.size() - 1, 0) <= 0)
+    {
+        return std::nullopt;
+    }
+
+    return std::strtoul(buffer.data(), nullptr, 0);
 }
 
 unsigned long SysfsLed::getDelayOn()
@@ -109,9 +333,9 @@ unsigned long SysfsLed::getDelayOn()
     return getSysfsAttr<unsigned long>(root / attrDelayOn);
 }
 
-void SysfsLed::setDelayOn(unsigned long ms)
+int SysfsLed::setDelayOn(unsigned long ms)
 {
-    setSysfsAttr<unsigned long>(root / attrDelayOn, ms);
+    return setSysfsAttr(root / attrDelayOn, std::to_string(ms));
 }
 
 unsigned long SysfsLed::getDelayOff()
@@ -119,9 +343,22 @@ unsigned long SysfsLed::getDelayOff()
     return getSysfsAttr<unsigned long>(root / attrDelayOff);
 }
 
-void SysfsLed::setDelayOff(unsigned long ms)
+int SysfsLed::setDelayOff(unsigned long ms)
 {
-    setSysfsAttr<unsigned long>(root / attrDelayOff, ms);
+    return setSysfsAttr(root / attrDelayOff, std::to_string(ms));
+}
+
+fs::path SysfsLed::getDevice() const
+{
+    // The class entry links to <device>/leds/<name>
+    std::error_code ec;
+    auto path = fs::canonical(root, ec);
+    if (ec)
+    {
+        return {};
+    }
+
+    return path.parent_path().parent_path();
 }
 
 /* LED sysfs name can be any of
@@ -142,29 +379,8 @@ void SysfsLed::setDelayOff(unsigned long ms)
  */
 LedDescr SysfsLed::getLedDescr()
 {
-    std::string name = std::string(root).substr(strlen(devParent));
-    LedDescr ledDescr;
-
-    std::vector<std::optional<std::string>> words;
-    std::stringstream ss(name);
-    std::string item;
-
-    while (std::getline(ss, item, ':'))
-    {
-        if (item.empty())
-        {
-            words.emplace_back(std::nullopt);
-        }
-        else
-        {
-            words.emplace_back(item);
-        }
-    }
-
-    if (name.ends_with(":"))
-    {
-        words.emplace_back(std::nullopt);
-    }
+    std::string_view name = root.native();
+    name.remove_prefix(std::min(name.size(), strlen(devParent)));
 
     if (name.empty())
     {
@@ -172,34 +388,22 @@ LedDescr SysfsLed::getLedDescr()
         throw std::out_of_range("expected non-empty LED name");
     }
 
-    if (words.size() != 3)
+    if (std::ranges::count(name, ':') != 2)
     {
         lg2::warning(
             "LED description '{DESC}' not well formed, expected 3 parts but got {NPARTS}",
-            "DESC", name, "NPARTS", words.size());
-    }
-
-    switch (words.size())
-    {
-        default:
-        case 3:
-            ledDescr.function = words.at(2);
-            ledDescr.color = words.at(1);
-            ledDescr.devicename = words.at(0);
-            break;
-        case 2:
-            ledDescr.color = words.at(0);
-            ledDescr.function = words.at(1);
-            break;
-        case 1:
-            ledDescr.devicename = words.at(0);
-            break;
-        case 0:
-            throw std::out_of_range("expected non-empty LED name");
+            "DESC", name, "NPARTS", std::ranges::count(name, ':') + 1);
     }
 
     // if there is more than 3 parts we ignore the rest
-    return ledDescr;
+    auto parts = parseLedName(name);
+    auto toOptional = [](std::string_view part) {
+        return part.empty() ? std::nullopt
+                            : std::optional<std::string>(part);
+    };
+
+    return {toOptional(parts.devicename), toOptional(parts.color),
+            toOptional(parts.function)};
 }
 } // namespace led
 } // namespace phosphor
@@ -15,8 +15,12 @@
  */
 
 #pragma once
+#include <array>
 #include <filesystem>
 #include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
 
 static constexpr auto devParent = "/sys/class/leds/";
 
@@ -35,6 +39,54 @@ struct LedDescr
     std::optional<std::string> function;
 };
 
+/** @brief Parts of a sysfs LED name, absent parts are empty
+ *
+ *  The parts are views into the parsed name.
+ */
+struct LedNameParts
+{
+    std::string_view devicename;
+    std::string_view color;
+    std::string_view function;
+
+    constexpr bool operator==(const LedNameParts&) const = default;
+};
+
+/** @brief Splits a sysfs LED name into its parts without allocating
+ *
+ *  See SysfsLed::getLedDescr for the name forms. Parts beyond the third
+ *  are ignored.
+ *
+ *  @param[in] name - LED name, the directory name in sysfs
+ *  @return the parts of the name
+ */
+constexpr LedNameParts parseLedName(std::string_view name)
+{
+    std::array<std::string_view, 3> words{};
+    size_t count = 0;
+
+    while (count < words.size())
+    {
+        auto end = name.find(':');
+        words[count++] = name.substr(0, end);
+        if (end == std::string_view::npos)
+        {
+            break;
+        }
+        name.remove_prefix(end + 1);
+    }
+
+    switch (count)
+    {
+        case 3:
+            return {words[0], words[1], words[2]};
+        case 2:
+            return {{}, words[0], words[1]};
+        default:
+            return {words[0], {}, {}};
+    }
+}
+
 class SysfsLed
 {
   public:
@@ -45,17 +97,46 @@ class SysfsLed
     SysfsLed& operator=(const SysfsLed& other) = delete;
     SysfsLed&& operator=(const SysfsLed&& other) = delete;
 
-    virtual ~SysfsLed() = default;
+    virtual ~SysfsLed();
+
+    /* The setters return 0 on success and -errno if the write failed,
+     * e.g. -ENXIO or -EREMOTEIO for a device not answering on its bus.
+     */
 
     virtual unsigned long getBrightness();
-    virtual void setBrightness(unsigned long brightness);
+    virtual int setBrightness(unsigned long brightness);
     virtual unsigned long getMaxBrightness();
     virtual std::string getTrigger();
-    virtual void setTrigger(const std::string& trigger);
+    virtual std::vector<std::string> getTriggers();
+    virtual int setTrigger(const std::string& trigger);
+    virtual int setTriggerAttr(const std::string& attr,
+                               const std::string& value);
+    virtual bool hasAttr(const std::string& attr);
+    virtual std::vector<std::string> getMultiIndex();
+    virtual std::vector<unsigned long> getMultiIntensity();
+    virtual int setMultiIntensity(const std::vector<unsigned long>& values);
+    virtual int getHwChangedFd();
+    virtual std::optional<unsigned long> getBrightnessHwChanged();
     virtual unsigned long getDelayOn();
-    virtual void setDelayOn(unsigned long ms);
+    virtual int setDelayOn(unsigned long ms);
     virtual unsigned long getDelayOff();
-    virtual void setDelayOff(unsigned long ms);
+    virtual int setDelayOff(unsigned long ms);
+
+    /** @brief Drops the cached active trigger, the next getTrigger()
+     *  reads it from sysfs again
+     *
+     *  getTrigger() and getTriggers() cache the active trigger, writes
+     *  through this class that may change it drop the cache.
+     */
+    void invalidateTrigger()
+    {
+        activeTrigger.reset();
+    }
+
+    /** @brief sysfs path of the device providing the LED, empty if the
+     *  LED does not exist
+     */
+    std::filesystem::path getDevice() const;
 
     /** @brief parse LED name in sysfs
      *  Parse sysfs LED name and sets corresponding
@@ -64,13 +145,39 @@ class SysfsLed
     LedDescr getLedDescr();
 
   protected:
+    friend class QueuedSysfsLed;
+
     static constexpr const char* attrBrightness = "brightness";
     static constexpr const char* attrMaxBrightness = "max_brightness";
     static constexpr const char* attrTrigger = "trigger";
     static constexpr const char* attrDelayOn = "delay_on";
     static constexpr const char* attrDelayOff = "delay_off";
+    static constexpr const char* attrMultiIndex = "multi_index";
+    static constexpr const char* attrMultiIntensity = "multi_intensity";
+    static constexpr const char* attrBrightnessHwChanged =
+        "brightness_hw_changed";
 
     std::filesystem::path root;
+
+  private:
+    /** @brief Descriptor of the brightness attribute, -1 until opened */
+    int brightnessFd = -1;
+
+    /** @brief Opens the brightness attribute on first use
+     *
+     *  Fades write the brightness every frame, the descriptor is kept
+     *  open for the lifetime of the LED instead of opening the file per
+     *  access.
+     *
+     *  @return the descriptor, -1 if the attribute can not be opened
+     */
+    int getBrightnessFd();
+
+    /** @brief Descriptor of brightness_hw_changed, -1 until opened */
+    int hwChangedFd = -1;
+
+    /** @brief Active trigger, read from sysfs until invalidated */
+    std::optional<std::string> activeTrigger;
 };
 } // namespace led
 } // namespace phosphor
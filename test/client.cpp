@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "interfaces/internal_interface.hpp"
+#include "phosphor-led-sysfs/client.hpp"
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/exception.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::led;
+using Action = client::Action;
+
+namespace
+{
+
+/** @brief LED accepting every write without touching sysfs */
+class StaticLed : public SysfsLed
+{
+  public:
+    StaticLed() : SysfsLed(fs::path("/sys/class/leds/static")) {}
+
+    unsigned long getBrightness() override
+    {
+        return 0;
+    }
+    int setBrightness(unsigned long /*value*/) override
+    {
+        return 0;
+    }
+    unsigned long getMaxBrightness() override
+    {
+        return 255;
+    }
+    std::string getTrigger() override
+    {
+        return "none";
+    }
+    std::vector<std::string> getTriggers() override
+    {
+        return {"none", "timer"};
+    }
+    int setTrigger(const std::string& /*trigger*/) override
+    {
+        return 0;
+    }
+    bool hasAttr(const std::string& /*attr*/) override
+    {
+        return false;
+    }
+    int getHwChangedFd() override
+    {
+        return -1;
+    }
+};
+
+} // namespace
+
+TEST(Client, set_states)
+{
+    auto event = sdeventplus::Event::get_new();
+    auto server = sdbusplus::bus::new_default();
+    auto bus = sdbusplus::bus::new_default();
+    sysfs::interface::InternalInterface internal(server, ledPath, event);
+    internal.addLED("identify", std::make_unique<StaticLed>(), "");
+    internal.addLED("fault", std::make_unique<StaticLed>(), "");
+
+    // The bus belongs to the dispatcher once it runs
+    auto service = server.get_unique_name();
+    std::atomic<bool> done = false;
+    std::thread dispatcher([&server, &done]() {
+        while (!done)
+        {
+            server.process_discard();
+            server.wait(std::chrono::milliseconds(10));
+        }
+    });
+
+    auto identify = std::string(physParent) + "/identify";
+    auto fault = std::string(physParent) + "/fault";
+    client::Controller leds(bus, service);
+    auto& proxy = leds.get(identify);
+    EXPECT_EQ(proxy.getState(), Action::Off);
+
+    // The last State of an LED wins
+    EXPECT_EQ(leds.batch()
+                  .setState(identify, Action::Blink)
+                  .setState(identify, Action::On)
+                  .commit(),
+              1U);
+    EXPECT_EQ(proxy.getState(), Action::On);
+
+    // LEDs already in the State are left out
+    EXPECT_EQ(leds.batch().setState(identify, Action::On).commit(), 0U);
+
+    // An unknown path fails the call before any LED is set
+    try
+    {
+        leds.batch()
+            .setState(fault, Action::On)
+            .setState(std::string(physParent) + "/unknown", Action::On)
+            .commit();
+        ADD_FAILURE() << "SetStates accepted an unknown LED";
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        EXPECT_STREQ(e.name(),
+                     "xyz.openbmc_project.Common.Error.ResourceNotFound");
+    }
+    EXPECT_EQ(leds.get(fault).getState(), Action::Off);
+
+    done = true;
+    dispatcher.join();
+}
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "frame_scheduler.hpp"
+
+#include <sdeventplus/event.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::led;
+using namespace std::chrono_literals;
+
+TEST(FrameScheduler, fades_in)
+{
+    auto event = sdeventplus::Event::get_new();
+    FrameScheduler frames(event);
+    std::vector<unsigned long> written;
+    int owner = 0;
+
+    frames.start(&owner, {&getBrightnessTable(255), 0, 100, 50ms,
+                          [&written](unsigned long value) {
+                              written.emplace_back(value);
+                          }});
+    while (frames.isActive(&owner))
+    {
+        event.run(std::nullopt);
+    }
+
+    ASSERT_GE(written.size(), 2U);
+    EXPECT_EQ(written.front(), 0U);
+    EXPECT_EQ(written.back(), 255U);
+    EXPECT_TRUE(std::ranges::is_sorted(written));
+
+    // At most one frame per minInterval, plus the first and last one
+    EXPECT_LE(written.size(),
+              static_cast<size_t>(50ms / FrameScheduler::minInterval) + 2);
+}
+
+TEST(FrameScheduler, concurrent_fades)
+{
+    auto event = sdeventplus::Event::get_new();
+    FrameScheduler frames(event);
+    std::array<unsigned long, 200> values{};
+
+    for (auto& value : values)
+    {
+        frames.start(&value, {&getBrightnessTable(255), 100, 0, 20ms,
+                              [&value](unsigned long v) { value = v; }});
+    }
+    while (std::ranges::any_of(
+        values, [&frames](const auto& value) { return frames.isActive(&value); }))
+    {
+        event.run(std::nullopt);
+    }
+
+    EXPECT_TRUE(std::ranges::all_of(values, [](auto v) { return v == 0; }));
+}
+
+TEST(FrameScheduler, stop)
+{
+    auto event = sdeventplus::Event::get_new();
+    FrameScheduler frames(event);
+    size_t written = 0;
+    int owner = 0;
+
+    frames.start(&owner, {&getBrightnessTable(255), 0, 100, 1000ms,
+                          [&written](unsigned long) { written++; }});
+    EXPECT_TRUE(frames.isActive(&owner));
+    EXPECT_EQ(written, 1U);
+
+    frames.stop(&owner);
+    EXPECT_FALSE(frames.isActive(&owner));
+}
@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "gamma.hpp"
+
+#include <gtest/gtest.h>
+
+using phosphor::led::getBrightnessTable;
+using phosphor::led::makeBrightnessTable;
+using phosphor::led::maxLevel;
+using phosphor::led::toLevel;
+
+static_assert(makeBrightnessTable(255)[0] == 0);
+static_assert(makeBrightnessTable(255)[maxLevel] == 255);
+static_assert(makeBrightnessTable(255)[1] == 1);
+static_assert(makeBrightnessTable(1)[1] == 1);
+static_assert(makeBrightnessTable(0)[maxLevel] == 0);
+
+TEST(Gamma, perceptual_midpoint)
+{
+    // Half the perceived brightness is less than a fifth of the light
+    EXPECT_EQ(getBrightnessTable(255)[50], 47U);
+    EXPECT_EQ(getBrightnessTable(4095)[50], 754U);
+}
+
+TEST(Gamma, shared_tables)
+{
+    EXPECT_EQ(&getBrightnessTable(255), &getBrightnessTable(255));
+    EXPECT_EQ(&getBrightnessTable(4095), &getBrightnessTable(4095));
+    EXPECT_NE(&getBrightnessTable(255), &getBrightnessTable(4095));
+}
+
+TEST(Gamma, to_level)
+{
+    const auto& table = getBrightnessTable(255);
+    for (uint8_t level = 0; level <= maxLevel; level++)
+    {
+        // Low levels share a value, any of them restores the value
+        EXPECT_EQ(table[toLevel(table, table[level])], table[level]);
+    }
+    EXPECT_EQ(toLevel(table, 47), 50);
+    EXPECT_EQ(toLevel(table, 0), 0);
+    EXPECT_EQ(toLevel(table, 255), maxLevel);
+    EXPECT_EQ(toLevel(table, 256), maxLevel);
+
+    // Between two levels, the lower one
+    EXPECT_EQ(toLevel(table, table[51] - 1), 50);
+}
+
+TEST(Gamma, to_level_on_off)
+{
+    // Every level above 0 lights an on/off LED, lit means fully on
+    const auto& table = getBrightnessTable(1);
+    EXPECT_EQ(toLevel(table, 0), 0);
+    EXPECT_EQ(toLevel(table, 1), maxLevel);
+}
@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "lag_monitor.hpp"
+
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/event.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::led;
+using namespace std::chrono_literals;
+
+TEST(LagMonitor, histogram)
+{
+    auto event = sdeventplus::Event::get_new();
+    LagMonitor monitor(event);
+
+    monitor.record(nullptr, 500us);
+    monitor.record(nullptr, 1ms);
+    monitor.record(nullptr, 3ms);
+    monitor.record(nullptr, 1h);
+
+    const auto& histogram = monitor.getWriteHistogram();
+    EXPECT_EQ(histogram[0], 1U);
+    EXPECT_EQ(histogram[1], 1U);
+    EXPECT_EQ(histogram[2], 1U);
+    EXPECT_EQ(histogram.back(), 1U);
+}
+
+TEST(LagMonitor, offenders)
+{
+    auto event = sdeventplus::Event::get_new();
+    LagMonitor monitor(event);
+    std::array<std::string, LagMonitor::offenderCount + 1> names;
+
+    for (size_t i = 0; i < names.size(); i++)
+    {
+        names[i] = "led" + std::to_string(i);
+        monitor.add(&names[i], names[i]);
+        monitor.record(&names[i], std::chrono::milliseconds(i + 1));
+    }
+    monitor.record(&names.back(), 1ms);
+
+    // The slowest first, each LED once, the fastest dropped
+    const auto& offenders = monitor.getOffenders();
+    ASSERT_EQ(offenders.size(), LagMonitor::offenderCount);
+    EXPECT_EQ(offenders.front().name, names.back());
+    EXPECT_EQ(offenders.front().duration, 6ms);
+    EXPECT_EQ(offenders.back().name, "led1");
+}
+
+TEST(LagMonitor, dispatch)
+{
+    auto event = sdeventplus::Event::get_new();
+    LagMonitor monitor(event);
+    sdeventplus::source::Defer handler(event, [&event](auto&) {
+        std::this_thread::sleep_for(2ms);
+        event.exit(0);
+    });
+
+    // The handler is timed, not the wait for it
+    EXPECT_EQ(monitor.loop(), 0);
+    const auto& histogram = monitor.getDispatchHistogram();
+    EXPECT_GE(std::accumulate(histogram.begin(), histogram.end(), uint64_t{0}),
+              1U);
+    EXPECT_GE(monitor.getMaxDispatch(), 2ms);
+}
@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "led_backend.hpp"
+
+#include <cerrno>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace phosphor::led;
+using ::testing::InSequence;
+using ::testing::Return;
+
+/* Not derived from SysfsLed, the sequences call the mock directly */
+class MockBackend
+{
+  public:
+    MOCK_METHOD(int, setBrightness, (unsigned long value));
+    MOCK_METHOD(int, setTrigger, (const std::string& trigger));
+    MOCK_METHOD(int, setTriggerAttr,
+                (const std::string& attr, const std::string& value));
+    MOCK_METHOD(int, setDelayOn, (unsigned long ms));
+    MOCK_METHOD(int, setDelayOff, (unsigned long ms));
+};
+
+static_assert(LedBackend<MockBackend>);
+
+TEST(LedBackend, writeSteady)
+{
+    InSequence s;
+
+    MockBackend led;
+    EXPECT_CALL(led, setTrigger("none")).WillOnce(Return(0));
+    EXPECT_CALL(led, setBrightness(255)).WillOnce(Return(0));
+    EXPECT_EQ(0, writeSteady(led, 255));
+}
+
+TEST(LedBackend, writeBlink)
+{
+    InSequence s;
+
+    MockBackend led;
+    EXPECT_CALL(led, setTrigger("timer")).WillOnce(Return(0));
+    EXPECT_CALL(led, setDelayOn(500)).WillOnce(Return(0));
+    EXPECT_CALL(led, setDelayOff(500)).WillOnce(Return(0));
+    EXPECT_CALL(led, setBrightness(255)).WillOnce(Return(0));
+    EXPECT_EQ(0, writeBlink(led, 500, 500, 255));
+
+    // The first failed write ends the sequence
+    EXPECT_CALL(led, setTrigger("timer")).WillOnce(Return(-ENXIO));
+    EXPECT_EQ(-ENXIO, writeBlink(led, 500, 500, std::nullopt));
+}
+
+TEST(LedBackend, QueuedSysfsLed)
+{
+    SysfsLed led(std::filesystem::path("/nonexistent/led"));
+    QueuedSysfsLed queued(led);
+
+    // The writes are only recorded, in order, with their attribute path
+    EXPECT_EQ(0, writeBlink(queued, 500, 250, std::nullopt));
+    auto writes = queued.take();
+    ASSERT_EQ(writes.size(), 3U);
+    EXPECT_EQ(writes[0].path, "/nonexistent/led/trigger");
+    EXPECT_EQ(writes[0].value, "timer");
+    EXPECT_EQ(writes[1].path, "/nonexistent/led/delay_on");
+    EXPECT_EQ(writes[1].value, "500");
+    EXPECT_EQ(writes[2].path, "/nonexistent/led/delay_off");
+    EXPECT_EQ(writes[2].value, "250");
+}
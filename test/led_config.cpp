@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "led_config.hpp"
+
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+using phosphor::led::LedConfig;
+using Action = LedConfig::Action;
+
+TEST(LedConfig, parse)
+{
+    auto config = LedConfig::parse(R"({
+        "leds": [
+            {
+                "sysfs": "platform:blue:identify",
+                "aliases": ["identify", "blue:identify"],
+                "name": "identify",
+                "state": "Blink"
+            },
+            {
+                "sysfs": "fault",
+                "name": "fault",
+                "color": "amber"
+            }
+        ]
+    })");
+
+    ASSERT_EQ(2U, config.getEntries().size());
+
+    const auto* identify = config.find("platform:blue:identify");
+    ASSERT_NE(nullptr, identify);
+    EXPECT_EQ("identify", identify->name);
+    EXPECT_EQ("blue", identify->color);
+    EXPECT_EQ(Action::Blink, identify->state);
+
+    // Aliases resolve to the same LED
+    EXPECT_EQ(identify, config.find("identify"));
+    EXPECT_EQ(identify, config.find("blue:identify"));
+
+    const auto* fault = config.find("fault");
+    ASSERT_NE(nullptr, fault);
+    EXPECT_EQ("amber", fault->color);
+    EXPECT_EQ(std::nullopt, fault->state);
+
+    EXPECT_EQ(nullptr, config.find("power"));
+
+    // Without a rateLimit section writes are not limited
+    EXPECT_EQ(0U, config.getRateLimit().rate);
+}
+
+TEST(LedConfig, invalid)
+{
+    EXPECT_THROW(LedConfig::parse("[]"), std::invalid_argument);
+    EXPECT_THROW(LedConfig::parse("{"), std::invalid_argument);
+    EXPECT_THROW(LedConfig::parse(R"({"leds": [{"name": "fault"}]})"),
+                 std::invalid_argument);
+    EXPECT_THROW(
+        LedConfig::parse(R"({"leds": [{"sysfs": "a:b", "name": "a:b"}]})"),
+        std::invalid_argument);
+    EXPECT_THROW(LedConfig::parse(R"({"leds": [
+                     {"sysfs": "fault", "name": "fault", "state": "Dim"}
+                 ]})"),
+                 std::invalid_argument);
+
+    // Names and sysfs names have to be unique, aliases included
+    EXPECT_THROW(LedConfig::parse(R"({"leds": [
+                     {"sysfs": "a", "name": "fault"},
+                     {"sysfs": "b", "name": "fault"}
+                 ]})"),
+                 std::invalid_argument);
+    EXPECT_THROW(LedConfig::parse(R"({"leds": [
+                     {"sysfs": "a", "name": "a"},
+                     {"sysfs": "b", "name": "b", "aliases": ["a"]}
+                 ]})"),
+                 std::invalid_argument);
+}
+
+TEST(LedConfig, rate_limit)
+{
+    auto config = LedConfig::parse(R"({"rateLimit": {"rate": 20}})");
+    EXPECT_EQ(20U, config.getRateLimit().rate);
+    EXPECT_EQ(10U, config.getRateLimit().burst);
+}
+
+TEST(LedConfig, absent)
+{
+    auto config = LedConfig::load("/nonexistent/leds.json");
+    EXPECT_TRUE(config.getEntries().empty());
+}
+
+TEST(LedConfig, groups)
+{
+    auto config = LedConfig::parse(R"({
+        "leds": [
+            {"sysfs": "front", "name": "front_identify"},
+            {"sysfs": "rear", "name": "rear_identify"}
+        ],
+        "groups": [
+            {"name": "identify", "members": ["front_identify", "rear_identify"]}
+        ]
+    })");
+
+    ASSERT_EQ(1U, config.getGroups().size());
+    EXPECT_EQ("identify", config.getGroups()[0].name);
+    EXPECT_EQ(2U, config.getGroups()[0].members.size());
+
+    // Members have to be configured, names are shared with the LEDs
+    EXPECT_THROW(LedConfig::parse(R"({
+                     "groups": [{"name": "identify", "members": ["front"]}]
+                 })"),
+                 std::invalid_argument);
+    EXPECT_THROW(LedConfig::parse(R"({
+                     "leds": [{"sysfs": "front", "name": "identify"}],
+                     "groups": [{"name": "identify", "members": ["identify"]}]
+                 })"),
+                 std::invalid_argument);
+}
@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "interfaces/internal_interface.hpp"
+
+#include <malloc.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::led;
+
+namespace
+{
+
+/** @brief LED answering like a typical 8 bit LED without touching sysfs */
+class StaticLed : public SysfsLed
+{
+  public:
+    StaticLed() : SysfsLed(fs::path("/sys/class/leds/static")) {}
+
+    unsigned long getBrightness() override
+    {
+        return 0;
+    }
+    int setBrightness(unsigned long /*value*/) override
+    {
+        return 0;
+    }
+    unsigned long getMaxBrightness() override
+    {
+        return 255;
+    }
+    std::string getTrigger() override
+    {
+        return "none";
+    }
+    std::vector<std::string> getTriggers() override
+    {
+        return {"none",       "kbd-scrolllock", "kbd-numlock", "kbd-capslock",
+                "timer",      "oneshot",        "heartbeat",   "backlight",
+                "default-on", "transient",      "pattern",     "netdev",
+                "mmc0",       "panic",          "disk-activity"};
+    }
+    int setTrigger(const std::string& /*trigger*/) override
+    {
+        return 0;
+    }
+    bool hasAttr(const std::string& /*attr*/) override
+    {
+        return false;
+    }
+    int getHwChangedFd() override
+    {
+        return -1;
+    }
+};
+
+size_t getAllocated()
+{
+    return mallinfo2().uordblks;
+}
+
+} // namespace
+
+TEST(Memory, bytes_per_led)
+{
+    constexpr size_t count = 256;
+
+    auto event = sdeventplus::Event::get_new();
+    auto bus = sdbusplus::bus::new_default();
+    sysfs::interface::InternalInterface internal(bus, ledPath, event);
+
+    // Shared tables and pools are filled by the first LED
+    internal.addLED("warmup", std::make_unique<StaticLed>(), "");
+
+    auto before = getAllocated();
+    for (size_t i = 0; i < count; i++)
+    {
+        internal.addLED("drive" + std::to_string(i) + "_fault",
+                        std::make_unique<StaticLed>(), "amber");
+    }
+    auto after = getAllocated();
+    ASSERT_GE(after, before);
+    auto perLed = (after - before) / count;
+    RecordProperty("BytesPerLed", std::to_string(perLed));
+
+    // Only Physical registers a vtable per LED, the other interfaces are
+    // served by one fallback vtable each
+    ASSERT_LT(perLed, 8192U);
+}
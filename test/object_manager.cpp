@@ -0,0 +1,195 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "interfaces/internal_interface.hpp"
+#include "led_config.hpp"
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/message.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::led;
+using namespace phosphor::led::sysfs::interface;
+
+namespace
+{
+
+/** @brief RGB LED accepting every write without touching sysfs */
+class StaticLed : public SysfsLed
+{
+  public:
+    StaticLed() : SysfsLed(fs::path("/sys/class/leds/static")) {}
+
+    unsigned long getBrightness() override
+    {
+        return 0;
+    }
+    int setBrightness(unsigned long /*value*/) override
+    {
+        return 0;
+    }
+    unsigned long getMaxBrightness() override
+    {
+        return 255;
+    }
+    std::string getTrigger() override
+    {
+        return "none";
+    }
+    std::vector<std::string> getTriggers() override
+    {
+        return {"none", "timer", "heartbeat", "pattern"};
+    }
+    int setTrigger(const std::string& /*trigger*/) override
+    {
+        return 0;
+    }
+    int setTriggerAttr(const std::string& /*attr*/,
+                       const std::string& /*value*/) override
+    {
+        return 0;
+    }
+    bool hasAttr(const std::string& attr) override
+    {
+        return attr == "multi_index";
+    }
+    std::vector<std::string> getMultiIndex() override
+    {
+        return {"red", "green", "blue"};
+    }
+    std::vector<unsigned long> getMultiIntensity() override
+    {
+        return {0, 0, 0};
+    }
+    int setMultiIntensity(const std::vector<unsigned long>& /*values*/) override
+    {
+        return 0;
+    }
+    int getHwChangedFd() override
+    {
+        return -1;
+    }
+};
+
+using Value =
+    std::variant<std::string, uint8_t, uint16_t, uint64_t,
+                 std::vector<std::string>, std::vector<uint32_t>,
+                 std::map<std::string, std::string>>;
+using Properties = std::map<std::string, Value>;
+using Objects = std::map<sdbusplus::message::object_path,
+                         std::map<std::string, Properties>>;
+
+/** @brief Serves the controller while a call from another connection is
+ *  made, so nothing else touches the server concurrently
+ */
+template <typename Call>
+auto serving(sdbusplus::bus_t& server, Call&& call)
+{
+    std::atomic<bool> done = false;
+    std::thread dispatcher([&server, &done]() {
+        while (!done)
+        {
+            server.process_discard();
+            server.wait(std::chrono::milliseconds(10));
+        }
+    });
+
+    auto result = call();
+
+    done = true;
+    dispatcher.join();
+    return result;
+}
+
+} // namespace
+
+TEST(ObjectManager, cache_invalidated)
+{
+    auto event = sdeventplus::Event::get_new();
+    auto server = sdbusplus::bus::new_default();
+    auto bus = sdbusplus::bus::new_default();
+    InternalInterface internal(server, ledPath, event);
+    internal.addLED("rgb", std::make_unique<StaticLed>(), "");
+
+    auto service = server.get_unique_name();
+    auto path = std::string(physParent) + "/rgb";
+    auto managed = [&](const char* interface) {
+        return serving(server, [&]() {
+            auto m = bus.new_method_call(service.c_str(), ledPath,
+                                         "org.freedesktop.DBus.ObjectManager",
+                                         "GetManagedObjects");
+            auto objects = bus.call(m).unpack<Objects>();
+            return objects.at(sdbusplus::message::object_path(path))
+                .at(interface);
+        });
+    };
+    auto call = [&](const char* interface, const char* method,
+                    auto&&... args) {
+        serving(server, [&]() {
+            auto m = bus.new_method_call(service.c_str(), path.c_str(),
+                                         interface, method);
+            m.append(args...);
+            bus.call(m);
+            return 0;
+        });
+    };
+    auto set = [&](const char* interface, const char* property,
+                   Value value) {
+        call("org.freedesktop.DBus.Properties", "Set", interface, property,
+             value);
+    };
+
+    // Fill the cache first, every change below has to invalidate it
+    EXPECT_EQ(std::get<std::string>(managed(triggerInterface).at("Trigger")),
+              "none");
+
+    call(triggerInterface, "SetTrigger", std::string("heartbeat"),
+         std::map<std::string, std::string>{});
+    EXPECT_EQ(std::get<std::string>(managed(triggerInterface).at("Trigger")),
+              "heartbeat");
+
+    call(patternInterface, "SetPattern",
+         std::vector<std::tuple<uint8_t, uint16_t>>{{100, 500}, {0, 500}},
+         int32_t(1));
+    EXPECT_EQ(std::get<std::string>(managed(triggerInterface).at("Trigger")),
+              "pattern");
+
+    set(dimmingInterface, "Brightness", uint8_t(40));
+    EXPECT_EQ(std::get<uint8_t>(managed(dimmingInterface).at("Brightness")),
+              40);
+
+    set(multiColorInterface, "Intensity", std::vector<uint32_t>{1, 2, 3});
+    EXPECT_EQ(std::get<std::vector<uint32_t>>(
+                  managed(multiColorInterface).at("Intensity")),
+              (std::vector<uint32_t>{1, 2, 3}));
+}
+
+TEST(ObjectManager, led_named_like_group)
+{
+    auto event = sdeventplus::Event::get_new();
+    auto bus = sdbusplus::bus::new_default();
+    InternalInterface internal(bus, ledPath, event);
+    internal.preregisterLEDs(LedConfig::parse(R"({
+        "leds": [{"sysfs": "front", "name": "front_identify"}],
+        "groups": [{"name": "identify", "members": ["front_identify"]}]
+    })"));
+
+    // An unconfigured sysfs LED must not take over the path of the group
+    EXPECT_EQ(internal.addLED("identify", std::make_unique<StaticLed>(), ""),
+              nullptr);
+    EXPECT_NE(internal.addLED("rgb", std::make_unique<StaticLed>(), ""),
+              nullptr);
+}
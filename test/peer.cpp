@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "interfaces/internal_interface.hpp"
+#include "interfaces/peer_interface.hpp"
+#include "interfaces/peer_server.hpp"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/exception.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::led;
+using sysfs::interface::PeerInterface;
+using sysfs::interface::PeerServer;
+using sysfs::interface::physicalInterface;
+
+namespace
+{
+
+/** @brief LED accepting every write without touching sysfs */
+class StaticLed : public SysfsLed
+{
+  public:
+    StaticLed() : SysfsLed(fs::path("/sys/class/leds/static")) {}
+
+    unsigned long getBrightness() override
+    {
+        return 0;
+    }
+    int setBrightness(unsigned long /*value*/) override
+    {
+        return 0;
+    }
+    unsigned long getMaxBrightness() override
+    {
+        return 255;
+    }
+    std::string getTrigger() override
+    {
+        return "none";
+    }
+    std::vector<std::string> getTriggers() override
+    {
+        return {"none", "timer"};
+    }
+    int setTrigger(const std::string& /*trigger*/) override
+    {
+        return 0;
+    }
+    bool hasAttr(const std::string& /*attr*/) override
+    {
+        return false;
+    }
+    int getHwChangedFd() override
+    {
+        return -1;
+    }
+};
+
+} // namespace
+
+TEST(Peer, object_name)
+{
+    std::string parent = physParent;
+    EXPECT_EQ(PeerInterface::objectName(parent + "/identify"), "identify");
+
+    // Nothing after the prefix
+    EXPECT_FALSE(PeerInterface::objectName(parent));
+    EXPECT_FALSE(PeerInterface::objectName(parent + "/"));
+
+    // Only the objects right below it
+    EXPECT_FALSE(PeerInterface::objectName(parent + "/identify/child"));
+    EXPECT_FALSE(PeerInterface::objectName(parent + "s/identify"));
+    EXPECT_FALSE(PeerInterface::objectName("/identify"));
+}
+
+TEST(Peer, is_allowed)
+{
+    auto other = geteuid() + 1;
+    EXPECT_TRUE(PeerServer::isAllowed(0, {}, std::nullopt));
+    EXPECT_TRUE(PeerServer::isAllowed(geteuid(), {}, std::nullopt));
+
+    // The group of the socket, as primary or supplementary group
+    EXPECT_TRUE(PeerServer::isAllowed(other, {100, 42}, 42));
+    EXPECT_FALSE(PeerServer::isAllowed(other, {100, 43}, 42));
+    EXPECT_FALSE(PeerServer::isAllowed(other, {42}, std::nullopt));
+}
+
+TEST(Peer, set_get)
+{
+    auto event = sdeventplus::Event::get_new();
+    auto bus = sdbusplus::bus::new_default();
+    sysfs::interface::InternalInterface internal(bus, ledPath, event);
+    internal.addLED("identify", std::make_unique<StaticLed>(), "");
+
+    std::array<int, 2> fds{};
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0,
+                            fds.data()));
+    auto server = PeerServer::openPeer(fds[0]);
+    PeerInterface objects(server, internal);
+
+    sd_bus* raw = nullptr;
+    ASSERT_LE(0, sd_bus_new(&raw));
+    auto peer = sdbusplus::bus_t(raw, std::false_type());
+    ASSERT_LE(0, sd_bus_set_fd(raw, fds[1], fds[1]));
+    ASSERT_LE(0, sd_bus_start(raw));
+
+    // The bus belongs to the dispatcher once it runs
+    std::atomic<bool> done = false;
+    std::thread dispatcher([&server, &done]() {
+        while (!done)
+        {
+            server.process_discard();
+            server.wait(std::chrono::milliseconds(10));
+        }
+    });
+
+    // Calls on a peer connection carry no destination
+    auto identify = std::string(physParent) + "/identify";
+    auto set = peer.new_method_call(nullptr, identify.c_str(),
+                                    "org.freedesktop.DBus.Properties", "Set");
+    set.append(physicalInterface, "State",
+               std::variant<std::string>(
+                   "xyz.openbmc_project.Led.Physical.Action.On"));
+    peer.call(set);
+
+    auto get = peer.new_method_call(nullptr, identify.c_str(),
+                                    "org.freedesktop.DBus.Properties", "Get");
+    get.append(physicalInterface, "State");
+    auto state = peer.call(get).unpack<std::variant<std::string>>();
+    EXPECT_EQ(std::get<std::string>(state),
+              "xyz.openbmc_project.Led.Physical.Action.On");
+
+    // An unknown leaf resolves to no object
+    auto unknown = std::string(physParent) + "/unknown";
+    get = peer.new_method_call(nullptr, unknown.c_str(),
+                               "org.freedesktop.DBus.Properties", "Get");
+    get.append(physicalInterface, "State");
+    try
+    {
+        peer.call(get);
+        ADD_FAILURE() << "Get succeeded on an unknown LED";
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        EXPECT_STREQ(e.name(), "org.freedesktop.DBus.Error.UnknownObject");
+    }
+
+    done = true;
+    dispatcher.join();
+}
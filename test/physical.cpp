@@ -1,8 +1,14 @@
+#include "arbiter.hpp"
+#include "lamp_test.hpp"
+#include "logical.hpp"
 #include "physical.hpp"
 
 #include <sys/param.h>
 
 #include <sdbusplus/bus.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <cerrno>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -58,14 +64,24 @@ class MockLed : public phosphor::led::SysfsLed
     }
 
     MOCK_METHOD0(getBrightness, unsigned long());
-    MOCK_METHOD1(setBrightness, void(unsigned long value));
+    MOCK_METHOD1(setBrightness, int(unsigned long value));
     MOCK_METHOD0(getMaxBrightness, unsigned long());
     MOCK_METHOD0(getTrigger, std::string());
-    MOCK_METHOD1(setTrigger, void(const std::string& trigger));
+    MOCK_METHOD0(getTriggers, std::vector<std::string>());
+    MOCK_METHOD1(setTrigger, int(const std::string& trigger));
+    MOCK_METHOD2(setTriggerAttr,
+                 int(const std::string& attr, const std::string& value));
+    MOCK_METHOD1(hasAttr, bool(const std::string& attr));
+    MOCK_METHOD0(getMultiIndex, std::vector<std::string>());
+    MOCK_METHOD0(getMultiIntensity, std::vector<unsigned long>());
+    MOCK_METHOD1(setMultiIntensity,
+                 int(const std::vector<unsigned long>& values));
+    MOCK_METHOD0(getHwChangedFd, int());
+    MOCK_METHOD0(getBrightnessHwChanged, std::optional<unsigned long>());
     MOCK_METHOD0(getDelayOn, unsigned long());
-    MOCK_METHOD1(setDelayOn, void(unsigned long ms));
+    MOCK_METHOD1(setDelayOn, int(unsigned long ms));
     MOCK_METHOD0(getDelayOff, unsigned long());
-    MOCK_METHOD1(setDelayOff, void(unsigned long ms));
+    MOCK_METHOD1(setDelayOff, int(unsigned long ms));
 };
 
 using ::testing::InSequence;
@@ -212,3 +228,746 @@ TEST(Physical, on_to_off)
     phy.state(Action::Off);
     EXPECT_EQ(phy.state(), Action::Off);
 }
+
+TEST(Physical, set_trigger_netdev)
+{
+    InSequence s;
+
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getTriggers())
+        .WillByDefault(Return(std::vector<std::string>{"none", "netdev"}));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    EXPECT_CALL(*led, setTrigger("netdev"));
+    EXPECT_CALL(*led, setTriggerAttr("device_name", "eth0"));
+    EXPECT_CALL(*led, setTriggerAttr("rx", "1"));
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+    phy.setTrigger("netdev", {{"rx", "1"}, {"device_name", "eth0"}});
+    EXPECT_EQ(phy.getTrigger(), "netdev");
+}
+
+TEST(Physical, set_trigger_unsupported)
+{
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getTriggers())
+        .WillByDefault(Return(std::vector<std::string>{"none", "netdev"}));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    EXPECT_CALL(*led, setTrigger(::testing::_)).Times(0);
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+    EXPECT_ANY_THROW(phy.setTrigger("heartbeat", {}));
+    EXPECT_ANY_THROW(phy.setTrigger("netdev", {{"../brightness", "1"}}));
+    EXPECT_EQ(phy.getTrigger(), "none");
+}
+
+TEST(Physical, set_trigger_failed)
+{
+    InSequence s;
+
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getTriggers())
+        .WillByDefault(Return(std::vector<std::string>{"none", "netdev"}));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    EXPECT_CALL(*led, setTrigger("netdev"));
+    EXPECT_CALL(*led, setTriggerAttr("device_name", "eth0"))
+        .WillOnce(Return(-EIO));
+    EXPECT_CALL(*led, setTriggerAttr("rx", "1")).Times(0);
+    EXPECT_CALL(*led, setTrigger("none"));
+    EXPECT_CALL(*led, setBrightness(phosphor::led::deasserted));
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+
+    // A trigger selected without its attributes is taken back
+    EXPECT_ANY_THROW(
+        phy.setTrigger("netdev", {{"rx", "1"}, {"device_name", "eth0"}}));
+    EXPECT_EQ(phy.getTrigger(), "none");
+    EXPECT_EQ(phy.state(), Action::Off);
+}
+
+TEST(Physical, state_after_trigger)
+{
+    constexpr unsigned long asserted = 127;
+
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getMaxBrightness()).WillByDefault(Return(asserted));
+    ON_CALL(*led, getTriggers())
+        .WillByDefault(Return(std::vector<std::string>{"none", "heartbeat"}));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    EXPECT_CALL(*led, setTrigger("heartbeat"));
+    EXPECT_CALL(*led, setTrigger("none"));
+    EXPECT_CALL(*led, setBrightness(phosphor::led::deasserted));
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+    phy.setTrigger("heartbeat", {});
+    EXPECT_EQ(phy.state(), Action::Off);
+
+    // Setting the unchanged State takes the LED back from the kernel
+    phy.state(Action::Off);
+    EXPECT_EQ(phy.getTrigger(), "none");
+}
+
+TEST(Physical, pattern_kernel)
+{
+    InSequence s;
+
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getMaxBrightness()).WillByDefault(Return(255));
+    ON_CALL(*led, getTriggers())
+        .WillByDefault(Return(std::vector<std::string>{"none", "pattern"}));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    EXPECT_CALL(*led, setTrigger("pattern"));
+    EXPECT_CALL(*led, setTriggerAttr("repeat", "3"));
+    EXPECT_CALL(*led, setTriggerAttr("pattern",
+                                     "255 200 255 0 0 200 0 0 255 600 255 0"));
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+    phy.setPattern({{100, 200}, {0, 200}, {100, 600}}, 3);
+    EXPECT_EQ(phy.getTrigger(), "pattern");
+}
+
+TEST(Physical, pattern_invalid)
+{
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getTriggers())
+        .WillByDefault(Return(std::vector<std::string>{"none", "pattern"}));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    EXPECT_CALL(*led, setTrigger(::testing::_)).Times(0);
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+    EXPECT_ANY_THROW(phy.setPattern({{100, 0}}, 1));
+    EXPECT_ANY_THROW(phy.setPattern({{101, 100}}, 1));
+    EXPECT_ANY_THROW(phy.setPattern({{100, 100}}, 0));
+}
+
+TEST(Physical, pattern_without_sequencer)
+{
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+    EXPECT_ANY_THROW(phy.setPattern({{100, 100}}, 1));
+}
+
+TEST(Physical, pulse_oneshot)
+{
+    InSequence s;
+
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getTriggers())
+        .WillByDefault(Return(std::vector<std::string>{"none", "oneshot"}));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    EXPECT_CALL(*led, setTrigger("oneshot"));
+    EXPECT_CALL(*led, setTriggerAttr("invert", "0"));
+    EXPECT_CALL(*led, setTriggerAttr("delay_on", "50"));
+    EXPECT_CALL(*led, setTriggerAttr("delay_off", "50"));
+    EXPECT_CALL(*led, setTriggerAttr("shot", "1")).Times(2);
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+
+    // Only the first pulse arms the trigger
+    phy.pulse(50);
+    phy.pulse(50);
+}
+
+TEST(Physical, pulse_blinking)
+{
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getTriggers())
+        .WillByDefault(Return(std::vector<std::string>{"none", "oneshot"}));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("timer"));
+    ON_CALL(*led, getDelayOn()).WillByDefault(Return(500));
+    ON_CALL(*led, getDelayOff()).WillByDefault(Return(500));
+    EXPECT_CALL(*led, setTrigger("oneshot")).Times(0);
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+    EXPECT_ANY_THROW(phy.pulse(50));
+}
+
+TEST(Physical, pulse_sequencer)
+{
+    InSequence s;
+
+    auto event = sdeventplus::Event::get_new();
+    phosphor::led::Sequencer sequencer(event);
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getMaxBrightness()).WillByDefault(Return(255));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    EXPECT_CALL(*led, setBrightness(255));
+    EXPECT_CALL(*led, setBrightness(phosphor::led::deasserted));
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+    phy.setSequencer(&sequencer);
+
+    // The second pulse is coalesced into the first one
+    phy.pulse(5);
+    phy.pulse(5);
+    while (sequencer.isActive(&phy))
+    {
+        event.run(std::nullopt);
+    }
+}
+
+TEST(Physical, multicolor_set_color)
+{
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getMaxBrightness()).WillByDefault(Return(255));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    ON_CALL(*led, hasAttr("multi_index")).WillByDefault(Return(true));
+    ON_CALL(*led, getMultiIndex())
+        .WillByDefault(
+            Return(std::vector<std::string>{"green", "red", "blue"}));
+    EXPECT_CALL(*led, setMultiIntensity(std::vector<unsigned long>{128, 255, 0}));
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+    ASSERT_NE(phy.getMultiColor(), nullptr);
+    phy.setColor(255, 128, 0);
+    EXPECT_EQ(phy.getMultiColor()->intensity,
+              (std::vector<unsigned long>{128, 255, 0}));
+}
+
+TEST(Physical, multicolor_invalid_intensity)
+{
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getMaxBrightness()).WillByDefault(Return(255));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    ON_CALL(*led, hasAttr("multi_index")).WillByDefault(Return(true));
+    ON_CALL(*led, getMultiIndex())
+        .WillByDefault(Return(std::vector<std::string>{"red", "green"}));
+    EXPECT_CALL(*led, setMultiIntensity(::testing::_)).Times(0);
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+    EXPECT_ANY_THROW(phy.setIntensity({1, 2, 3}));
+    EXPECT_ANY_THROW(phy.setIntensity({1, 256}));
+}
+
+TEST(Physical, multicolor_intensity_failed)
+{
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getMaxBrightness()).WillByDefault(Return(255));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    ON_CALL(*led, hasAttr("multi_index")).WillByDefault(Return(true));
+    ON_CALL(*led, getMultiIndex())
+        .WillByDefault(Return(std::vector<std::string>{"red", "green"}));
+    ON_CALL(*led, getMultiIntensity())
+        .WillByDefault(Return(std::vector<unsigned long>{10, 20}));
+    EXPECT_CALL(*led, setMultiIntensity(::testing::_))
+        .WillOnce(Return(-EREMOTEIO));
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+
+    // The intensities the LED still shows are kept
+    EXPECT_ANY_THROW(phy.setIntensity({1, 2}));
+    EXPECT_EQ(phy.getMultiColor()->intensity,
+              (std::vector<unsigned long>{10, 20}));
+}
+
+TEST(Physical, single_color_set_color)
+{
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+    EXPECT_EQ(phy.getMultiColor(), nullptr);
+    EXPECT_ANY_THROW(phy.setColor(255, 255, 255));
+}
+
+TEST(Physical, dimmed_on)
+{
+    InSequence s;
+
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getMaxBrightness()).WillByDefault(Return(255));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    EXPECT_CALL(*led, setBrightness(47));
+    EXPECT_CALL(*led, setBrightness(255));
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+
+    // Dimming an Off LED only takes effect once it is lit
+    phy.setLevel(50);
+    phy.state(Action::On);
+    phy.setLevel(100);
+    EXPECT_EQ(phy.getLevel(), 100);
+}
+
+TEST(Physical, dimmed_blink)
+{
+    InSequence s;
+
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getMaxBrightness()).WillByDefault(Return(255));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    EXPECT_CALL(*led, setTrigger("timer"));
+    EXPECT_CALL(*led, setBrightness(47));
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+    phy.setLevel(50);
+    phy.state(Action::Blink);
+}
+
+TEST(Physical, ctor_dimmed)
+{
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getMaxBrightness()).WillByDefault(Return(255));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    ON_CALL(*led, getBrightness()).WillByDefault(Return(47));
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+    EXPECT_EQ(phy.state(), Action::On);
+    EXPECT_EQ(phy.getLevel(), 50);
+    EXPECT_ANY_THROW(phy.setLevel(0));
+    EXPECT_ANY_THROW(phy.setLevel(101));
+}
+
+TEST(Physical, fade_in_kernel)
+{
+    InSequence s;
+
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getMaxBrightness()).WillByDefault(Return(255));
+    ON_CALL(*led, getTriggers())
+        .WillByDefault(Return(std::vector<std::string>{"none", "pattern"}));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    EXPECT_CALL(*led, setTrigger("pattern"));
+    EXPECT_CALL(*led, setTriggerAttr("repeat", "1"));
+    EXPECT_CALL(*led,
+                setTriggerAttr("pattern", "0 50 3 50 8 50 16 50 29 50 47 50 "
+                                          "72 50 104 50 145 50 195 50 255 0"));
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+    phy.setFadeIn(500);
+    phy.state(Action::On);
+    EXPECT_EQ(phy.getTrigger(), "pattern");
+}
+
+TEST(Physical, fade_out_frames)
+{
+    auto event = sdeventplus::Event::get_new();
+    phosphor::led::FrameScheduler frames(event);
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getMaxBrightness()).WillByDefault(Return(255));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    ON_CALL(*led, getBrightness()).WillByDefault(Return(255));
+    EXPECT_CALL(*led, setBrightness(255));
+    EXPECT_CALL(*led, setBrightness(phosphor::led::deasserted));
+    EXPECT_CALL(*led, setBrightness(::testing::AllOf(::testing::Gt(0U),
+                                                      ::testing::Lt(255U))))
+        .Times(::testing::AtLeast(1));
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+    phy.setFrameScheduler(&frames);
+    phy.setFadeOut(50);
+    phy.state(Action::Off);
+    while (frames.isActive(&phy))
+    {
+        event.run(std::nullopt);
+    }
+}
+
+TEST(Physical, fade_on_off_led)
+{
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getMaxBrightness()).WillByDefault(Return(1));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+    EXPECT_ANY_THROW(phy.setFadeIn(500));
+    EXPECT_NO_THROW(phy.setFadeIn(0));
+}
+
+TEST(Physical, hardware_changed)
+{
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getMaxBrightness()).WillByDefault(Return(255));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    EXPECT_CALL(*led, getBrightnessHwChanged())
+        .WillOnce(Return(std::nullopt))
+        .WillOnce(Return(255))
+        .WillOnce(Return(0));
+    EXPECT_CALL(*led, setBrightness(::testing::_)).Times(0);
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+    size_t changes = 0;
+    phy.onChange([&changes]() { changes++; });
+
+    // Nothing changed by hardware yet
+    phy.hardwareChanged();
+    EXPECT_EQ(phy.state(), Action::Off);
+
+    phy.hardwareChanged();
+    EXPECT_EQ(phy.state(), Action::On);
+
+    phy.hardwareChanged();
+    EXPECT_EQ(phy.state(), Action::Off);
+    EXPECT_EQ(changes, 2U);
+}
+
+TEST(Physical, scrub_drift)
+{
+    InSequence s;
+
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getMaxBrightness()).WillByDefault(Return(255));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    EXPECT_CALL(*led, getBrightness()).WillOnce(Return(255));
+    EXPECT_CALL(*led, getBrightness()).WillOnce(Return(255));
+    EXPECT_CALL(*led, getBrightness()).WillOnce(Return(0));
+    EXPECT_CALL(*led, setTrigger("none"));
+    EXPECT_CALL(*led, setBrightness(255));
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+
+    EXPECT_FALSE(phy.scrub());
+
+    // Someone else turned the LED off, it is turned back on
+    EXPECT_TRUE(phy.scrub());
+    EXPECT_EQ(phy.state(), Action::On);
+}
+
+TEST(Physical, scrub_blink)
+{
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    auto* mock = led.get();
+    ON_CALL(*led, getMaxBrightness()).WillByDefault(Return(255));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("timer"));
+    ON_CALL(*led, getDelayOn()).WillByDefault(Return(500));
+    ON_CALL(*led, getDelayOff()).WillByDefault(Return(500));
+    EXPECT_CALL(*led, setTrigger("timer")).Times(2);
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+    EXPECT_EQ(phy.state(), Action::Blink);
+
+    EXPECT_FALSE(phy.scrub());
+
+    // A driver reset dropped the timer trigger, blinking is restarted
+    ON_CALL(*mock, getTrigger()).WillByDefault(Return("none"));
+    EXPECT_TRUE(phy.scrub());
+
+    // A driver rounding the delays is corrected once, then left alone
+    ON_CALL(*mock, getTrigger()).WillByDefault(Return("timer"));
+    ON_CALL(*mock, getDelayOn()).WillByDefault(Return(400));
+    EXPECT_TRUE(phy.scrub());
+    EXPECT_FALSE(phy.scrub());
+    EXPECT_EQ(phy.state(), Action::Blink);
+}
+
+TEST(Physical, bind_applies_state)
+{
+    auto bus = sdbusplus::bus::new_default();
+    phosphor::led::Physical phy(bus, ledObj, "", Action::Off);
+    EXPECT_FALSE(phy.isBound());
+    EXPECT_TRUE(phy.getTriggers().empty());
+
+    // Requests before the device appears are kept
+    phy.state(Action::On);
+    EXPECT_EQ(phy.state(), Action::On);
+    EXPECT_FALSE(phy.scrub());
+
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getMaxBrightness()).WillByDefault(Return(255));
+    ON_CALL(*led, getTriggers())
+        .WillByDefault(Return(std::vector<std::string>{"none", "timer"}));
+    EXPECT_CALL(*led, setTrigger("none"));
+    EXPECT_CALL(*led, setBrightness(255));
+    phy.bind(std::move(led));
+
+    EXPECT_TRUE(phy.isBound());
+    EXPECT_EQ(phy.state(), Action::On);
+    EXPECT_EQ(2U, phy.getTriggers().size());
+}
+
+TEST(Physical, bind_keeps_hardware_state)
+{
+    auto bus = sdbusplus::bus::new_default();
+    phosphor::led::Physical phy(bus, ledObj, "", std::nullopt);
+    EXPECT_EQ(phy.state(), Action::Off);
+
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getMaxBrightness()).WillByDefault(Return(255));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    ON_CALL(*led, getBrightness()).WillByDefault(Return(255));
+    EXPECT_CALL(*led, setBrightness(::testing::_)).Times(0);
+    phy.bind(std::move(led));
+
+    EXPECT_EQ(phy.state(), Action::On);
+}
+
+TEST(Physical, logical_fan_out)
+{
+    auto bus = sdbusplus::bus::new_default();
+    std::vector<std::unique_ptr<phosphor::led::Physical>> leds;
+    for (const auto* path : {"/foo/bar/led0", "/foo/bar/led1"})
+    {
+        auto led = std::make_unique<NiceMock<MockLed>>();
+        ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+        EXPECT_CALL(*led, setTrigger("timer"));
+        EXPECT_CALL(*led, setDelayOn(500));
+        // Once to blink, once more to restart all timers together
+        EXPECT_CALL(*led, setDelayOff(500)).Times(2);
+        leds.emplace_back(std::make_unique<phosphor::led::Physical>(
+            bus, path, std::move(led)));
+    }
+
+    phosphor::led::Logical group(bus, ledObj, {leds[0].get(), leds[1].get()});
+    EXPECT_EQ(group.state(), Action::Off);
+
+    group.state(Action::Blink);
+    EXPECT_EQ(leds[0]->state(), Action::Blink);
+    EXPECT_EQ(leds[1]->state(), Action::Blink);
+    EXPECT_EQ(group.state(), Action::Blink);
+}
+
+TEST(Physical, logical_state_derived)
+{
+    auto bus = sdbusplus::bus::new_default();
+    std::vector<std::unique_ptr<phosphor::led::Physical>> leds;
+    for (const auto* path : {"/foo/bar/led0", "/foo/bar/led1"})
+    {
+        auto led = std::make_unique<NiceMock<MockLed>>();
+        ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+        ON_CALL(*led, getMaxBrightness()).WillByDefault(Return(255));
+        leds.emplace_back(std::make_unique<phosphor::led::Physical>(
+            bus, path, std::move(led)));
+    }
+
+    phosphor::led::Logical group(bus, ledObj, {leds[0].get(), leds[1].get()});
+
+    // Any lit member lights the group
+    leds[1]->state(Action::On);
+    EXPECT_EQ(group.state(), Action::On);
+
+    group.state(Action::Off);
+    EXPECT_EQ(leds[1]->state(), Action::Off);
+    EXPECT_EQ(group.state(), Action::Off);
+}
+
+TEST(Physical, arbitration)
+{
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getMaxBrightness()).WillByDefault(Return(255));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    EXPECT_CALL(*led, setBrightness(255));
+    EXPECT_CALL(*led, setTrigger("timer"));
+    EXPECT_CALL(*led, setBrightness(0));
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+    phosphor::led::Arbiter arbiter(bus);
+
+    arbiter.request(phy, ":1.1", 10, Action::On);
+    EXPECT_EQ(phy.state(), Action::On);
+
+    // A lower priority neither wins nor writes
+    arbiter.request(phy, ":1.2", 5, Action::On);
+    arbiter.request(phy, ":1.2", 5, Action::Blink);
+    EXPECT_EQ(phy.state(), Action::On);
+
+    // Once the winner leaves, the next request takes over
+    arbiter.releaseAll(":1.1");
+    EXPECT_EQ(phy.state(), Action::Blink);
+
+    EXPECT_FALSE(arbiter.release(phy, ":1.2", 10));
+    EXPECT_TRUE(arbiter.release(phy, ":1.2", 5));
+    EXPECT_EQ(phy.state(), Action::Off);
+}
+
+TEST(Physical, arbitration_direct_state)
+{
+    InSequence s;
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getMaxBrightness()).WillByDefault(Return(255));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    EXPECT_CALL(*led, setBrightness(255));
+    EXPECT_CALL(*led, setBrightness(0));
+    EXPECT_CALL(*led, setBrightness(255));
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+    phosphor::led::Arbiter arbiter(bus);
+    phy.setArbiter(&arbiter);
+
+    arbiter.request(phy, ":1.1", 1, Action::On);
+
+    // State set directly is the request of the lowest priority, it shows
+    // once the other requests are withdrawn
+    EXPECT_EQ(phy.state(Action::Off), Action::On);
+    arbiter.releaseAll(":1.1");
+    EXPECT_EQ(phy.state(), Action::Off);
+
+    // Without other requests it applies right away
+    phy.state(Action::On);
+    EXPECT_EQ(phy.state(), Action::On);
+}
+
+TEST(Physical, rate_limited)
+{
+    InSequence s;
+
+    auto event = sdeventplus::Event::get_new();
+    phosphor::led::RateLimiter limiter(event, 100, 1);
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getMaxBrightness()).WillByDefault(Return(255));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    EXPECT_CALL(*led, setBrightness(255));
+    EXPECT_CALL(*led, setBrightness(0));
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+    phy.setRateLimiter(&limiter);
+    limiter.add(&phy, "/sys/devices/i2c-3/3-0020");
+
+    // Writes over budget are deferred and merged, never dropped
+    phy.state(Action::On);
+    phy.state(Action::Blink);
+    phy.state(Action::Off);
+    EXPECT_EQ(phy.state(), Action::Off);
+    while (limiter.isDeferred(&phy))
+    {
+        event.run(std::nullopt);
+    }
+
+    EXPECT_EQ(phy.getDeferredWrites(), 1U);
+    EXPECT_EQ(phy.getMergedWrites(), 1U);
+}
+
+TEST(Physical, rate_limited_unchanged)
+{
+    auto event = sdeventplus::Event::get_new();
+    phosphor::led::RateLimiter limiter(event, 100, 1);
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getMaxBrightness()).WillByDefault(Return(255));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    EXPECT_CALL(*led, setBrightness(255));
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+    phy.setRateLimiter(&limiter);
+    limiter.add(&phy, "/sys/devices/i2c-3/3-0020");
+
+    // Setting the State the LED is in leaves the token to the next write
+    phy.state(Action::Off);
+    phy.state(Action::On);
+    EXPECT_FALSE(limiter.isDeferred(&phy));
+    EXPECT_EQ(phy.getDeferredWrites(), 0U);
+}
+
+TEST(Physical, write_retried)
+{
+    InSequence s;
+
+    auto event = sdeventplus::Event::get_new();
+    phosphor::led::RetryScheduler retrier(event);
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getMaxBrightness()).WillByDefault(Return(255));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    EXPECT_CALL(*led, setBrightness(255)).WillOnce(Return(-ENXIO));
+    EXPECT_CALL(*led, setBrightness(255)).WillOnce(Return(0));
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+    phy.setRetryScheduler(&retrier);
+
+    // A device NACKing once is written again from the event loop
+    phy.state(Action::On);
+    while (retrier.isPending(&phy))
+    {
+        event.run(std::nullopt);
+    }
+
+    EXPECT_EQ(phy.state(), Action::On);
+    EXPECT_EQ(phy.getFailedWrites(), 1U);
+    EXPECT_EQ(phy.getAbandonedWrites(), 0U);
+}
+
+TEST(Physical, write_rolled_back)
+{
+    auto event = sdeventplus::Event::get_new();
+    phosphor::led::RetryScheduler retrier(event);
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getMaxBrightness()).WillByDefault(Return(255));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    EXPECT_CALL(*led, setTrigger("timer")).WillOnce(Return(-EINVAL));
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+    phy.setRetryScheduler(&retrier);
+
+    // Retrying does not help, State goes back to what the LED shows
+    phy.state(Action::Blink);
+    EXPECT_FALSE(retrier.isPending(&phy));
+    EXPECT_EQ(phy.state(), Action::Off);
+    EXPECT_EQ(phy.getFailedWrites(), 1U);
+    EXPECT_EQ(phy.getAbandonedWrites(), 1U);
+}
+
+TEST(Physical, write_partial_rolled_back)
+{
+    InSequence s;
+
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getMaxBrightness()).WillByDefault(Return(255));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    EXPECT_CALL(*led, setTrigger("timer")).WillOnce(Return(0));
+    EXPECT_CALL(*led, setDelayOn(::testing::_)).WillOnce(Return(-EINVAL));
+    EXPECT_CALL(*led, setTrigger("none")).WillOnce(Return(0));
+    EXPECT_CALL(*led, setBrightness(0)).WillOnce(Return(0));
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+
+    // The timer trigger was set without its delays, the LED is driven
+    // back to the State that is published
+    phy.state(Action::Blink);
+    EXPECT_EQ(phy.state(), Action::Off);
+    EXPECT_EQ(phy.getAbandonedWrites(), 1U);
+}
+
+TEST(Physical, lamp_test)
+{
+    auto event = sdeventplus::Event::get_new();
+    phosphor::led::LampTest lampTest(event);
+    auto bus = sdbusplus::bus::new_default();
+    auto blinking = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*blinking, getMaxBrightness()).WillByDefault(Return(255));
+    ON_CALL(*blinking, getTrigger()).WillByDefault(Return("none"));
+    auto off = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*off, getMaxBrightness()).WillByDefault(Return(255));
+    ON_CALL(*off, getTrigger()).WillByDefault(Return("none"));
+    phosphor::led::Physical first(bus, ledObj, std::move(blinking));
+    phosphor::led::Physical second(bus, "/foo/bar/led2", std::move(off));
+    first.period(500);
+    first.state(Action::Blink);
+
+    lampTest.start({&first, &second}, std::chrono::milliseconds(10));
+    EXPECT_TRUE(lampTest.isActive());
+    EXPECT_EQ(first.state(), Action::On);
+    EXPECT_EQ(second.state(), Action::On);
+
+    // An LED set during the test keeps its State
+    second.state(Action::Blink);
+    while (lampTest.isActive())
+    {
+        event.run(std::nullopt);
+    }
+
+    EXPECT_EQ(first.state(), Action::Blink);
+    EXPECT_EQ(first.period(), 500);
+    EXPECT_EQ(second.state(), Action::Blink);
+    EXPECT_FALSE(lampTest.stop());
+}
+
+TEST(Physical, lamp_test_trigger)
+{
+    auto event = sdeventplus::Event::get_new();
+    phosphor::led::LampTest lampTest(event);
+    auto bus = sdbusplus::bus::new_default();
+    auto led = std::make_unique<NiceMock<MockLed>>();
+    ON_CALL(*led, getMaxBrightness()).WillByDefault(Return(255));
+    ON_CALL(*led, getTrigger()).WillByDefault(Return("none"));
+    ON_CALL(*led, getTriggers())
+        .WillByDefault(Return(std::vector<std::string>{"none", "netdev"}));
+    EXPECT_CALL(*led, setTrigger("netdev")).Times(2);
+    EXPECT_CALL(*led, setTriggerAttr("device_name", "eth0")).Times(2);
+    phosphor::led::Physical phy(bus, ledObj, std::move(led));
+    phy.setTrigger("netdev", {{"device_name", "eth0"}});
+
+    // The trigger comes back with its attributes after the test
+    lampTest.start({&phy}, std::chrono::milliseconds(10));
+    EXPECT_EQ(phy.getTrigger(), "none");
+    EXPECT_TRUE(lampTest.stop());
+    EXPECT_EQ(phy.getTrigger(), "netdev");
+    EXPECT_EQ(phy.getTriggerParams().at("device_name"), "eth0");
+}
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "rate_limiter.hpp"
+
+#include <sdeventplus/event.hpp>
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::led;
+using namespace std::chrono_literals;
+
+TEST(RateLimiter, burst_then_defer)
+{
+    auto event = sdeventplus::Event::get_new();
+    RateLimiter limiter(event, 100, 2);
+    int owner = 0;
+    int applied = 0;
+
+    limiter.add(&owner, "/sys/devices/i2c-3/3-0020");
+    EXPECT_TRUE(limiter.acquire(&owner));
+    EXPECT_TRUE(limiter.acquire(&owner));
+    EXPECT_FALSE(limiter.acquire(&owner));
+
+    // Writes deferred meanwhile are merged, the last one wins
+    auto start = std::chrono::steady_clock::now();
+    limiter.defer(&owner, [&applied]() { applied = 1; });
+    limiter.defer(&owner, [&applied]() { applied = 2; });
+    while (limiter.isDeferred(&owner))
+    {
+        event.run(std::nullopt);
+    }
+
+    EXPECT_EQ(applied, 2);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 5ms);
+}
+
+TEST(RateLimiter, devices)
+{
+    auto event = sdeventplus::Event::get_new();
+    RateLimiter limiter(event, 1, 1);
+    int first = 0;
+    int second = 0;
+    int unknown = 0;
+
+    // Every device has its own budget, LEDs without one are not limited
+    limiter.add(&first, "/sys/devices/i2c-3/3-0020");
+    limiter.add(&second, "/sys/devices/i2c-4/4-0020");
+    EXPECT_TRUE(limiter.acquire(&first));
+    EXPECT_TRUE(limiter.acquire(&second));
+    EXPECT_FALSE(limiter.acquire(&first));
+    for (int i = 0; i < 10; i++)
+    {
+        EXPECT_TRUE(limiter.acquire(&unknown));
+    }
+
+    limiter.defer(&first, []() {});
+    limiter.cancel(&first);
+    EXPECT_FALSE(limiter.isDeferred(&first));
+}
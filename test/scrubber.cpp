@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "scrubber.hpp"
+
+#include <sdeventplus/event.hpp>
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::led;
+using namespace std::chrono_literals;
+
+TEST(Scrubber, budget)
+{
+    auto event = sdeventplus::Event::get_new();
+    Scrubber scrubber(event, 1, 10ms);
+    int first = 0;
+    int second = 0;
+    int checks = 0;
+
+    scrubber.add(&first, [&checks]() {
+        checks++;
+        return false;
+    });
+    scrubber.add(&second, [&checks]() {
+        checks++;
+        return false;
+    });
+
+    // Both are due, the second waits a tick of the budget
+    auto start = std::chrono::steady_clock::now();
+    while (checks < 2)
+    {
+        event.run(std::nullopt);
+    }
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 1s);
+
+    scrubber.remove(&first);
+    scrubber.remove(&second);
+}
+
+TEST(Scrubber, remove)
+{
+    auto event = sdeventplus::Event::get_new();
+    Scrubber scrubber(event, 1, 10ms);
+    int owner = 0;
+    int checks = 0;
+
+    scrubber.add(&owner, [&checks]() {
+        checks++;
+        return true;
+    });
+    event.run(std::nullopt);
+    EXPECT_EQ(checks, 1);
+
+    // A removed LED is not checked again, and nothing is left to run
+    scrubber.remove(&owner);
+    EXPECT_EQ(event.run(0ms), 0);
+    EXPECT_EQ(checks, 1);
+}
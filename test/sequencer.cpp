@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "sequencer.hpp"
+
+#include <sdeventplus/event.hpp>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::led;
+
+TEST(Sequencer, plays_pattern)
+{
+    auto event = sdeventplus::Event::get_new();
+    Sequencer sequencer(event);
+    std::vector<uint8_t> applied;
+    int owner = 0;
+
+    sequencer.start(&owner, {{100, 5}, {0, 5}}, 2,
+                    [&applied](uint8_t brightness) {
+                        applied.emplace_back(brightness);
+                    });
+    while (sequencer.isActive(&owner))
+    {
+        event.run(std::nullopt);
+    }
+
+    EXPECT_EQ(applied, (std::vector<uint8_t>{100, 0, 100, 0}));
+}
+
+TEST(Sequencer, stop)
+{
+    auto event = sdeventplus::Event::get_new();
+    Sequencer sequencer(event);
+    size_t applied = 0;
+    int owner = 0;
+
+    sequencer.start(&owner, {{100, 5}}, repeatForever,
+                    [&applied](uint8_t) { applied++; });
+    EXPECT_TRUE(sequencer.isActive(&owner));
+    EXPECT_EQ(applied, 1U);
+
+    sequencer.stop(&owner);
+    EXPECT_FALSE(sequencer.isActive(&owner));
+}
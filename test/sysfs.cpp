@@ -21,6 +21,8 @@
 #include <cerrno>
 #include <cstdlib>
 #include <fstream>
+#include <iterator>
+#include <string>
 
 #include <gtest/gtest.h>
 
@@ -56,6 +58,27 @@ class FakeSysfsLed : public phosphor::led::SysfsLed
         fs::remove_all(root);
     }
 
+    /* A sysfs attribute takes the whole value in one write, the regular
+     * file behind the fake one has to be cut to it
+     */
+    int setBrightness(unsigned long brightness) override
+    {
+        int rc = SysfsLed::setBrightness(brightness);
+        if (rc == 0)
+        {
+            fs::resize_file(root / attrBrightness,
+                            std::to_string(brightness).size() + 1);
+        }
+        return rc;
+    }
+
+    std::string readAttr(const char* attr) const
+    {
+        std::ifstream f(root / attr);
+        return {std::istreambuf_iterator<char>(f),
+                std::istreambuf_iterator<char>()};
+    }
+
   private:
     explicit FakeSysfsLed(fs::path&& path) : SysfsLed(std::move(path))
     {
@@ -84,6 +107,17 @@ TEST(Sysfs, getBrightness)
     ASSERT_EQ(brightness, fsl.getBrightness());
 }
 
+TEST(Sysfs, setBrightnessShorter)
+{
+    FakeSysfsLed fsl = FakeSysfsLed::create();
+
+    // The descriptor is reused, a shorter value must not leave digits behind
+    fsl.setBrightness(127);
+    fsl.setBrightness(5);
+    ASSERT_EQ(5U, fsl.getBrightness());
+    ASSERT_EQ("5\n", fsl.readAttr("brightness"));
+}
+
 TEST(Sysfs, getMaxBrightness)
 {
     FakeSysfsLed fsl = FakeSysfsLed::create();
@@ -108,6 +142,51 @@ TEST(Sysfs, getTriggerBlink)
     ASSERT_EQ("timer", fsl.getTrigger());
 }
 
+TEST(Sysfs, getTriggers)
+{
+    FakeSysfsLed fsl = FakeSysfsLed::create();
+    fsl.setTrigger("none [timer] heartbeat netdev");
+    std::vector<std::string> expected = {"none", "timer", "heartbeat",
+                                         "netdev"};
+    ASSERT_EQ(expected, fsl.getTriggers());
+}
+
+TEST(Sysfs, getTriggerCached)
+{
+    FakeSysfsLed fsl = FakeSysfsLed::create();
+    fsl.setTrigger("none [timer] heartbeat netdev");
+
+    // The list and the active trigger come from a single read
+    fsl.getTriggers();
+    fsl.setTriggerAttr("trigger", "[none] timer heartbeat netdev");
+    ASSERT_EQ("timer", fsl.getTrigger());
+
+    fsl.invalidateTrigger();
+    ASSERT_EQ("none", fsl.getTrigger());
+}
+
+TEST(Sysfs, getMultiIntensity)
+{
+    FakeSysfsLed fsl = FakeSysfsLed::create();
+    std::vector<unsigned long> intensity = {255, 128, 0};
+
+    fsl.setMultiIntensity(intensity);
+    ASSERT_EQ(intensity, fsl.getMultiIntensity());
+}
+
+TEST(Sysfs, getBrightnessHwChanged)
+{
+    FakeSysfsLed fsl = FakeSysfsLed::create();
+
+    // Not every LED can be changed by hardware
+    ASSERT_EQ(-1, fsl.getHwChangedFd());
+    ASSERT_EQ(std::nullopt, fsl.getBrightnessHwChanged());
+
+    fsl.setTriggerAttr("brightness_hw_changed", "255");
+    ASSERT_LE(0, fsl.getHwChangedFd());
+    ASSERT_EQ(255U, fsl.getBrightnessHwChanged());
+}
+
 TEST(Sysfs, getDelayOn)
 {
     constexpr unsigned long delayOn = 250;
@@ -57,3 +57,28 @@ TEST(DbusName, WithUnderscore)
 
     ASSERT_EQ("enclosure_identify", name);
 }
+
+TEST(DbusName, WithForbiddenCharacters)
+{
+    LedDescr d = {"hdd0.fault", "amber", "status@1"};
+
+    std::string name = interface::InternalInterface::getDbusName(d);
+
+    ASSERT_EQ("hdd0_fault_status_1_amber", name);
+}
+
+TEST(DbusName, FromParts)
+{
+    std::string name = interface::InternalInterface::getDbusName(
+        parseLedName("input9::capslock"));
+
+    ASSERT_EQ("input9_capslock", name);
+}
+
+TEST(DbusName, Empty)
+{
+    std::string name =
+        interface::InternalInterface::getDbusName(parseLedName("::"));
+
+    ASSERT_EQ("", name);
+}
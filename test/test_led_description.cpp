@@ -21,6 +21,18 @@
 
 using namespace phosphor::led;
 
+// The documented name forms, parsed at compile time
+static_assert(parseLedName("devicename:color:function") ==
+              LedNameParts{"devicename", "color", "function"});
+static_assert(parseLedName("devicename:color:function:part4") ==
+              LedNameParts{"devicename", "color", "function"});
+static_assert(parseLedName("input9::capslock") ==
+              LedNameParts{"input9", "", "capslock"});
+static_assert(parseLedName("red:fault") == LedNameParts{"", "red", "fault"});
+static_assert(parseLedName("identify") == LedNameParts{"identify", "", ""});
+static_assert(parseLedName(":boot") == LedNameParts{"", "", "boot"});
+static_assert(parseLedName("green:") == LedNameParts{"", "green", ""});
+
 static LedDescr runtest(const std::string& name)
 {
     std::string path = devParent + name;
@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "triggers.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::led;
+
+TEST(Triggers, contains)
+{
+    TriggerSet set({"none", "kbd-capslock", "timer", "netdev", "disk-read"});
+
+    EXPECT_TRUE(set.contains(KnownTrigger::none));
+    EXPECT_TRUE(set.contains(KnownTrigger::timer));
+    EXPECT_FALSE(set.contains(KnownTrigger::pattern));
+
+    EXPECT_TRUE(set.contains("timer"));
+    EXPECT_TRUE(set.contains("netdev"));
+    EXPECT_TRUE(set.contains("disk-read"));
+    EXPECT_FALSE(set.contains("disk"));
+    EXPECT_FALSE(set.contains("oneshot"));
+
+    // The list keeps the order of the kernel
+    EXPECT_EQ(set.getNames()[1], "kbd-capslock");
+}
+
+TEST(Triggers, shared)
+{
+    const auto& first = getTriggerSet({"none", "timer"});
+    const auto& second = getTriggerSet({"none", "timer"});
+    const auto& other = getTriggerSet({"none"});
+
+    EXPECT_EQ(&first, &second);
+    EXPECT_NE(&first, &other);
+}
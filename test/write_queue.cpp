@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "write_queue.hpp"
+
+#include <sdeventplus/event.hpp>
+
+#include <cerrno>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using phosphor::led::WriteQueue;
+namespace fs = std::filesystem;
+
+static std::string readFile(const fs::path& path)
+{
+    std::string content;
+    std::ifstream file(path);
+    std::getline(file, content);
+    return content;
+}
+
+TEST(WriteQueue, writes)
+{
+    std::string tmplt = "/tmp/WriteQueue.XXXXXX";
+    fs::path root = mkdtemp(tmplt.data());
+    std::ofstream(root / "trigger").flush();
+    std::ofstream(root / "brightness").flush();
+
+    auto event = sdeventplus::Event::get_new();
+    WriteQueue queue(event);
+
+    std::optional<int> first;
+    std::optional<int> second;
+    {
+        WriteQueue::Batch batch(&queue);
+        queue.enqueue(&first,
+                      {{(root / "trigger").string(), "none"},
+                       {(root / "brightness").string(), "255"}},
+                      [&first](int rc) { first = rc; });
+
+        // The chain stops at the missing attribute
+        queue.enqueue(&second,
+                      {{(root / "delay_on").string(), "500"},
+                       {(root / "brightness").string(), "0"}},
+                      [&second](int rc) { second = rc; });
+    }
+    while (!first || !second)
+    {
+        event.run(std::nullopt);
+    }
+
+    EXPECT_EQ(0, *first);
+    EXPECT_EQ(-ENOENT, *second);
+    EXPECT_EQ("none", readFile(root / "trigger"));
+    EXPECT_EQ("255", readFile(root / "brightness"));
+    EXPECT_FALSE(queue.isPending(&first));
+
+    fs::remove_all(root);
+}
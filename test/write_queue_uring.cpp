@@ -0,0 +1,194 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "write_queue.hpp"
+
+#include <dlfcn.h>
+#include <liburing.h>
+
+#include <sdeventplus/event.hpp>
+
+#include <cerrno>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using phosphor::led::WriteQueue;
+namespace fs = std::filesystem;
+
+/* Error the next submissions fail with, 0 to submit */
+static int submitError = 0;
+
+/* Takes the place of the liburing one, so a test can refuse the
+ * submissions like a kernel short of resources
+ */
+extern "C" int io_uring_submit(struct io_uring* ring)
+{
+    if (submitError != 0)
+    {
+        return submitError;
+    }
+
+    using Submit = int (*)(struct io_uring*);
+    static auto* submit =
+        reinterpret_cast<Submit>(dlsym(RTLD_NEXT, "io_uring_submit"));
+    return submit(ring);
+}
+
+static std::string readFile(const fs::path& path)
+{
+    std::string content;
+    std::ifstream file(path);
+    std::getline(file, content);
+    return content;
+}
+
+class WriteQueueUring : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        std::string tmplt = "/tmp/WriteQueueUring.XXXXXX";
+        root = mkdtemp(tmplt.data());
+        std::ofstream(root / "trigger").flush();
+        std::ofstream(root / "brightness").flush();
+
+        // The kernel may refuse io_uring, e.g. in a container
+        WriteQueue::Batch batch(&queue);
+        if (!queue.isBatching())
+        {
+            GTEST_SKIP() << "io_uring is unavailable";
+        }
+    }
+
+    void TearDown() override
+    {
+        submitError = 0;
+        fs::remove_all(root);
+    }
+
+    sdeventplus::Event event = sdeventplus::Event::get_new();
+    WriteQueue queue{event};
+    fs::path root;
+};
+
+TEST_F(WriteQueueUring, completes_on_loop)
+{
+    std::optional<int> result;
+    {
+        WriteQueue::Batch batch(&queue);
+        queue.enqueue(&result,
+                      {{(root / "trigger").string(), "timer"},
+                       {(root / "brightness").string(), "128"}},
+                      [&result](int rc) { result = rc; });
+    }
+
+    // Submitted with the batch, called back once reaped
+    EXPECT_TRUE(queue.isPending(&result));
+    EXPECT_FALSE(result);
+    while (!result)
+    {
+        event.run(std::nullopt);
+    }
+
+    EXPECT_EQ(0, *result);
+    EXPECT_EQ("timer", readFile(root / "trigger"));
+    EXPECT_EQ("128", readFile(root / "brightness"));
+    EXPECT_FALSE(queue.isPending(&result));
+}
+
+TEST_F(WriteQueueUring, submit_failure)
+{
+    // More chains than file slots and ring entries, so some wait for
+    // room when the submission fails
+    std::vector<std::optional<int>> results(100);
+    submitError = -EBUSY;
+    {
+        WriteQueue::Batch batch(&queue);
+        for (auto& result : results)
+        {
+            queue.enqueue(&result,
+                          {{(root / "trigger").string(), "none"},
+                           {(root / "brightness").string(), "255"}},
+                          [&result](int rc) { result = rc; });
+        }
+    }
+
+    // Written synchronously, nothing stays pending
+    for (auto& result : results)
+    {
+        ASSERT_TRUE(result);
+        EXPECT_EQ(0, *result);
+        EXPECT_FALSE(queue.isPending(&result));
+    }
+    EXPECT_EQ("255", readFile(root / "brightness"));
+
+    // The slots are back and the ring still completes, the entries of
+    // the refused submission included
+    submitError = 0;
+    results.assign(results.size(), std::nullopt);
+    {
+        WriteQueue::Batch batch(&queue);
+        for (auto& result : results)
+        {
+            queue.enqueue(&result,
+                          {{(root / "trigger").string(), "timer"},
+                           {(root / "delay_on").string(), "500"}},
+                          [&result](int rc) { result = rc; });
+        }
+    }
+    for (auto& result : results)
+    {
+        while (!result)
+        {
+            event.run(std::nullopt);
+        }
+        EXPECT_EQ(-ENOENT, *result);
+    }
+    EXPECT_EQ("timer", readFile(root / "trigger"));
+}
+
+TEST_F(WriteQueueUring, superseded_callbacks)
+{
+    int owner = 0;
+    std::optional<int> first;
+    std::optional<int> second;
+
+    // Replaced before submission, both get the result of the new writes
+    {
+        WriteQueue::Batch batch(&queue);
+        queue.enqueue(&owner, {{(root / "brightness").string(), "64"}},
+                      [&first](int rc) { first = rc; });
+        queue.enqueue(&owner, {{(root / "delay_on").string(), "500"}},
+                      [&second](int rc) { second = rc; });
+    }
+    while (!first || !second)
+    {
+        event.run(std::nullopt);
+    }
+    EXPECT_EQ(-ENOENT, *first);
+    EXPECT_EQ(-ENOENT, *second);
+    EXPECT_EQ("", readFile(root / "brightness"));
+
+    // Followed while in flight, both get the result of the later writes
+    first.reset();
+    second.reset();
+    queue.enqueue(&owner, {{(root / "delay_on").string(), "500"}},
+                  [&first](int rc) { first = rc; });
+    EXPECT_TRUE(queue.isPending(&owner));
+    queue.enqueue(&owner, {{(root / "brightness").string(), "128"}},
+                  [&second](int rc) { second = rc; });
+    while (!first || !second)
+    {
+        event.run(std::nullopt);
+    }
+    EXPECT_EQ(0, *first);
+    EXPECT_EQ(0, *second);
+    EXPECT_EQ("128", readFile(root / "brightness"));
+    EXPECT_FALSE(queue.isPending(&owner));
+}
@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "triggers.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <limits>
+
+namespace phosphor
+{
+namespace led
+{
+
+TriggerSet::TriggerSet(std::vector<std::string> names) : names(std::move(names))
+{
+    const auto& list = this->names;
+    auto count =
+        std::min<size_t>(list.size(), std::numeric_limits<uint16_t>::max());
+
+    for (size_t i = 0; i < count; i++)
+    {
+        auto it = std::ranges::find(knownTriggers, list[i]);
+        if (it != knownTriggers.end())
+        {
+            known.set(std::distance(knownTriggers.begin(), it));
+        }
+        else
+        {
+            others.emplace_back(static_cast<uint16_t>(i));
+        }
+    }
+
+    std::ranges::sort(others, {},
+                      [&list](uint16_t i) -> const std::string& {
+                          return list[i];
+                      });
+}
+
+bool TriggerSet::contains(std::string_view trigger) const
+{
+    auto it = std::ranges::find(knownTriggers, trigger);
+    if (it != knownTriggers.end())
+    {
+        return known.test(std::distance(knownTriggers.begin(), it));
+    }
+
+    auto other = std::ranges::lower_bound(
+        others, trigger, std::less<>{},
+        [this](uint16_t i) -> std::string_view { return names[i]; });
+    return other != others.end() && names[*other] == trigger;
+}
+
+const TriggerSet& getTriggerSet(std::vector<std::string> names)
+{
+    // A deque keeps the sets in place as more are added
+    static std::deque<TriggerSet> sets;
+
+    auto it = std::ranges::find(sets, names, &TriggerSet::getNames);
+    if (it != sets.end())
+    {
+        return *it;
+    }
+
+    return sets.emplace_back(std::move(names));
+}
+
+} // namespace led
+} // namespace phosphor
@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace phosphor
+{
+namespace led
+{
+
+/** @brief Triggers the controller itself drives LEDs with */
+enum class KnownTrigger : uint8_t
+{
+    none,
+    timer,
+    pattern,
+    oneshot,
+    transient,
+};
+
+/** @brief Names of the known triggers, in the order of KnownTrigger */
+constexpr std::array<std::string_view, 5> knownTriggers = {
+    "none", "timer", "pattern", "oneshot", "transient",
+};
+
+/** @class TriggerSet
+ *  @brief Triggers the kernel supports for an LED
+ *
+ *  The trigger list of an LED is parsed once when the LED is bound. The
+ *  known triggers are kept as a bitset, the others, e.g. one per network
+ *  device, disk and CPU, in a sorted index. Lookups never touch sysfs.
+ */
+class TriggerSet
+{
+  public:
+    /** @brief Builds the set from the list read from sysfs
+     *
+     *  @param[in] names - triggers in the order the kernel lists them
+     */
+    explicit TriggerSet(std::vector<std::string> names);
+
+    /** @brief Whether the LED supports a known trigger */
+    bool contains(KnownTrigger trigger) const
+    {
+        return known.test(static_cast<size_t>(trigger));
+    }
+
+    /** @brief Whether the LED supports a trigger
+     *
+     *  @param[in] trigger - name of the trigger
+     */
+    bool contains(std::string_view trigger) const;
+
+    /** @brief The triggers in the order the kernel lists them */
+    const std::vector<std::string>& getNames() const
+    {
+        return names;
+    }
+
+  private:
+    /** @brief The triggers in the order the kernel lists them */
+    std::vector<std::string> names;
+
+    /** @brief Known triggers by KnownTrigger */
+    std::bitset<knownTriggers.size()> known;
+
+    /** @brief Positions in names of the other triggers, sorted by name */
+    std::vector<uint16_t> others;
+};
+
+/** @brief Shared trigger set of a trigger list
+ *
+ *  The LEDs of a system mostly share one trigger list, the set is built
+ *  once per distinct list.
+ *
+ *  @param[in] names - triggers in the order the kernel lists them
+ *  @return the set, its address is the same for equal lists
+ */
+const TriggerSet& getTriggerSet(std::vector<std::string> names);
+
+} // namespace led
+} // namespace phosphor
@@ -0,0 +1,416 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+
+#include "write_queue.hpp"
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#ifdef LED_SYSFS_URING
+#include <sys/eventfd.h>
+#endif
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+namespace phosphor
+{
+namespace led
+{
+
+WriteQueue::WriteQueue([[maybe_unused]] const sdeventplus::Event& event)
+{
+#ifdef LED_SYSFS_URING
+    auto rc = io_uring_queue_init(ringSize, &ring, 0);
+    if (rc < 0)
+    {
+        lg2::info("io_uring is unavailable, LEDs are written synchronously: "
+                  "{ERROR}",
+                  "ERROR", strerror(-rc));
+        return;
+    }
+
+    // Each chain opens its files into a registered slot, so the writes
+    // can be linked to the open
+    rc = io_uring_register_files_sparse(&ring, slotCount);
+    if (rc == 0)
+    {
+        eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        rc = eventFd < 0 ? -errno : io_uring_register_eventfd(&ring, eventFd);
+    }
+    if (rc < 0)
+    {
+        lg2::info("io_uring is unavailable, LEDs are written synchronously: "
+                  "{ERROR}",
+                  "ERROR", strerror(-rc));
+        io_uring_queue_exit(&ring);
+        if (eventFd >= 0)
+        {
+            close(eventFd);
+            eventFd = -1;
+        }
+        return;
+    }
+
+    for (unsigned slot = 0; slot < slotCount; ++slot)
+    {
+        freeSlots.emplace_back(slot);
+    }
+
+    completions.emplace(event, eventFd, EPOLLIN,
+                        [this](auto&, int fd, uint32_t) {
+                            uint64_t count = 0;
+                            [[maybe_unused]] auto n =
+                                read(fd, &count, sizeof(count));
+                            reap();
+                        });
+    available = true;
+#endif
+}
+
+WriteQueue::~WriteQueue()
+{
+    completions.reset();
+
+#ifdef LED_SYSFS_URING
+    if (available)
+    {
+        io_uring_queue_exit(&ring);
+    }
+#endif
+
+    if (eventFd >= 0)
+    {
+        close(eventFd);
+    }
+}
+
+void WriteQueue::enqueue(const void* owner, std::vector<Write> writes,
+                         Complete complete)
+{
+    if (!available)
+    {
+        complete(writeNow(writes));
+        return;
+    }
+
+    auto chain = std::make_unique<Chain>();
+    chain->owner = owner;
+    chain->writes = std::move(writes);
+
+    auto it = chains.find(owner);
+    if (it == chains.end())
+    {
+        chain->completes.emplace_back(std::move(complete));
+        chains.emplace(owner, std::move(chain));
+        waiting.emplace_back(owner);
+    }
+    else
+    {
+        // A chain not submitted yet is superseded by the new writes, or
+        // they follow the one in flight. The callbacks of a superseded
+        // chain wait for the writes taking its place.
+        auto& slot =
+            it->second->inFlight == 0 ? it->second : it->second->next;
+        if (slot)
+        {
+            chain->completes = std::move(slot->completes);
+        }
+        chain->completes.emplace_back(std::move(complete));
+        slot = std::move(chain);
+    }
+
+    if (depth == 0)
+    {
+        submit();
+    }
+}
+
+void WriteQueue::cancel(const void* owner)
+{
+    auto it = chains.find(owner);
+    if (it == chains.end())
+    {
+        return;
+    }
+
+    auto chain = std::move(it->second);
+    chains.erase(it);
+    std::erase(waiting, owner);
+
+    // The kernel still uses the buffers of a chain in flight
+    if (chain->inFlight > 0)
+    {
+        chain->completes.clear();
+        chain->next.reset();
+        orphans.emplace_back(std::move(chain));
+    }
+}
+
+void WriteQueue::begin()
+{
+    ++depth;
+}
+
+void WriteQueue::end()
+{
+    if (--depth == 0 && available)
+    {
+        submit();
+    }
+}
+
+void WriteQueue::submit()
+{
+#ifdef LED_SYSFS_URING
+    auto pending = std::exchange(waiting, {});
+    size_t submitted = 0;
+    for (; submitted < pending.size(); ++submitted)
+    {
+        auto& chain = *chains.at(pending[submitted]);
+
+        // Each write is an open, the write and a close
+        auto needed = static_cast<unsigned>(chain.writes.size() * 3);
+        if (freeSlots.empty() || io_uring_sq_space_left(&ring) < needed)
+        {
+            break;
+        }
+
+        chain.slot = freeSlots.back();
+        freeSlots.pop_back();
+        chain.inFlight = needed;
+
+        for (size_t i = 0; i < chain.writes.size(); ++i)
+        {
+            const auto& write = chain.writes[i];
+            bool last = i + 1 == chain.writes.size();
+
+            auto* sqe = io_uring_get_sqe(&ring);
+            io_uring_prep_openat_direct(sqe, AT_FDCWD, write.path.c_str(),
+                                        O_WRONLY, 0, chain.slot);
+            sqe->flags |= IOSQE_IO_LINK;
+            io_uring_sqe_set_data(sqe, &chain);
+            unsubmitted.emplace_back(sqe, &chain);
+
+            sqe = io_uring_get_sqe(&ring);
+            io_uring_prep_write(sqe, static_cast<int>(chain.slot),
+                                write.value.data(), write.value.size(), 0);
+            sqe->flags |= IOSQE_FIXED_FILE | IOSQE_IO_LINK;
+            io_uring_sqe_set_data(sqe, &chain);
+            unsubmitted.emplace_back(sqe, &chain);
+
+            // A failure cancels the rest of the chain, the close of the
+            // failed write included. The next open into the slot replaces
+            // the file left in it.
+            sqe = io_uring_get_sqe(&ring);
+            io_uring_prep_close_direct(sqe, chain.slot);
+            if (!last)
+            {
+                sqe->flags |= IOSQE_IO_LINK;
+            }
+            io_uring_sqe_set_data(sqe, &chain);
+            unsubmitted.emplace_back(sqe, &chain);
+        }
+    }
+
+    // Chains without room wait for completions
+    waiting.insert(waiting.begin(), pending.begin() + submitted,
+                   pending.end());
+
+    // Entries left by a partial submission go along with the new ones
+    if (io_uring_sq_ready(&ring) == 0)
+    {
+        return;
+    }
+
+    auto rc = io_uring_submit(&ring);
+    if (rc >= 0)
+    {
+        unsubmitted.erase(unsubmitted.begin(), unsubmitted.begin() + rc);
+        return;
+    }
+
+    // The kernel took none of the entries, they stay in the ring until
+    // the next submission. Chains with none of their entries in flight
+    // are written here, their entries turned into no-ops the reaping
+    // skips. The others are retried once their completions are reaped.
+    std::map<Chain*, unsigned> left;
+    for (const auto& [sqe, chain] : unsubmitted)
+    {
+        if (chain != nullptr)
+        {
+            ++left[chain];
+        }
+    }
+    std::erase_if(left, [](const auto& entry) {
+        return entry.second != entry.first->inFlight;
+    });
+    for (auto& [sqe, chain] : unsubmitted)
+    {
+        if (left.contains(chain))
+        {
+            io_uring_prep_nop(sqe);
+            sqe->flags = 0;
+            io_uring_sqe_set_data(sqe, nullptr);
+            chain = nullptr;
+        }
+    }
+
+    std::vector<Chain*> refused;
+    for (auto& [chain, count] : left)
+    {
+        freeSlots.emplace_back(chain->slot);
+        chain->inFlight = 0;
+        refused.emplace_back(chain);
+    }
+
+    // The chains without room would wait on the same ring
+    for (const auto* owner : waiting)
+    {
+        refused.emplace_back(chains.at(owner).get());
+    }
+    waiting.clear();
+
+    if (refused.empty())
+    {
+        return;
+    }
+
+    lg2::error("Unable to submit LED writes, writing them synchronously: "
+               "{ERROR}",
+               "ERROR", strerror(-rc));
+    for (auto* chain : refused)
+    {
+        chain->rc = writeNow(chain->writes);
+    }
+    finish(refused);
+#endif
+}
+
+void WriteQueue::reap()
+{
+#ifdef LED_SYSFS_URING
+    std::vector<Chain*> done;
+
+    io_uring_cqe* cqe = nullptr;
+    unsigned head = 0;
+    unsigned count = 0;
+    io_uring_for_each_cqe(&ring, head, cqe)
+    {
+        auto* chain = static_cast<Chain*>(io_uring_cqe_get_data(cqe));
+
+        // No-ops left by a failed submission
+        if (chain == nullptr)
+        {
+            ++count;
+            continue;
+        }
+
+        // Keep the error that broke the chain over the cancellations
+        if (cqe->res < 0 && (chain->rc == 0 || chain->rc == -ECANCELED))
+        {
+            chain->rc = cqe->res;
+        }
+
+        if (--chain->inFlight == 0)
+        {
+            freeSlots.emplace_back(chain->slot);
+            done.emplace_back(chain);
+        }
+        ++count;
+    }
+    io_uring_cq_advance(&ring, count);
+
+    finish(done);
+#endif
+}
+
+void WriteQueue::finish(const std::vector<Chain*>& done)
+{
+    // Callbacks may queue again, so the chains are retired first
+    std::vector<std::pair<Complete, int>> callbacks;
+    for (auto* chain : done)
+    {
+        // A short write cancels the chain without an error of its own
+        auto rc = chain->rc == -ECANCELED ? -EIO : chain->rc;
+
+        auto it = chains.find(chain->owner);
+        if (it == chains.end() || it->second.get() != chain)
+        {
+            std::erase_if(orphans, [chain](const auto& orphan) {
+                return orphan.get() == chain;
+            });
+            continue;
+        }
+
+        // Writes queued meanwhile set the whole State again, the result
+        // of those is what the callbacks get
+        if (chain->next)
+        {
+            auto next = std::move(chain->next);
+            next->completes.insert(
+                next->completes.begin(),
+                std::make_move_iterator(chain->completes.begin()),
+                std::make_move_iterator(chain->completes.end()));
+            it->second = std::move(next);
+            waiting.emplace_back(it->first);
+            continue;
+        }
+
+        for (auto& complete : chain->completes)
+        {
+            callbacks.emplace_back(std::move(complete), rc);
+        }
+        chains.erase(it);
+    }
+
+    submit();
+
+    for (auto& [complete, rc] : callbacks)
+    {
+        if (complete)
+        {
+            complete(rc);
+        }
+    }
+}
+
+int WriteQueue::writeNow(const std::vector<Write>& writes)
+{
+    for (const auto& write : writes)
+    {
+        int fd = open(write.path.c_str(), O_WRONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            return -errno;
+        }
+
+        int rc = 0;
+        auto written = pwrite(fd, write.value.data(), write.value.size(), 0);
+        if (written < 0)
+        {
+            rc = -errno;
+        }
+        else if (static_cast<size_t>(written) != write.value.size())
+        {
+            rc = -EIO;
+        }
+
+        close(fd);
+        if (rc != 0)
+        {
+            return rc;
+        }
+    }
+
+    return 0;
+}
+
+} // namespace led
+} // namespace phosphor
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef LED_SYSFS_URING
+#include <liburing.h>
+#endif
+
+namespace phosphor
+{
+namespace led
+{
+
+/** @class WriteQueue
+ *  @brief Submits the sysfs writes of many LEDs at once through io_uring
+ *
+ *  While a batch is open, the writes of each LED are queued as a chain
+ *  instead of being written one syscall at a time. When the outermost
+ *  batch closes, all chains go to the kernel in a single submission. The
+ *  writes of a chain run in order and stop at the first failure, chains
+ *  of different LEDs run independently. Completions are reaped on the
+ *  event loop. Chains the kernel refuses to take are written
+ *  synchronously instead.
+ *
+ *  Without io_uring, either not built in or refused by the kernel, no
+ *  batch is ever open and the LEDs keep writing synchronously.
+ */
+class WriteQueue
+{
+  public:
+    WriteQueue() = delete;
+    WriteQueue(const WriteQueue&) = delete;
+    WriteQueue& operator=(const WriteQueue&) = delete;
+    WriteQueue(WriteQueue&&) = delete;
+    WriteQueue& operator=(WriteQueue&&) = delete;
+
+    /** @brief One write of a sysfs attribute */
+    struct Write
+    {
+        std::string path;
+        std::string value;
+    };
+
+    /** @brief Receives 0 or the -errno of the first failed write */
+    using Complete = std::function<void(int)>;
+
+    /** @class Batch
+     *  @brief Keeps the writes queued while it lives
+     */
+    class Batch
+    {
+      public:
+        Batch() = delete;
+        Batch(const Batch&) = delete;
+        Batch& operator=(const Batch&) = delete;
+        Batch(Batch&&) = delete;
+        Batch& operator=(Batch&&) = delete;
+
+        /** @brief Opens a batch
+         *
+         *  @param[in] queue - the queue, nullptr for none
+         */
+        explicit Batch(WriteQueue* queue) : queue(queue)
+        {
+            if (queue != nullptr)
+            {
+                queue->begin();
+            }
+        }
+
+        ~Batch()
+        {
+            if (queue != nullptr)
+            {
+                queue->end();
+            }
+        }
+
+      private:
+        WriteQueue* queue;
+    };
+
+    /** @brief Sets up io_uring, the queue stays unused if it fails
+     *
+     *  @param[in] event - event loop to reap the completions on
+     */
+    explicit WriteQueue(const sdeventplus::Event& event);
+
+    ~WriteQueue();
+
+    /** @brief Whether writes are being queued */
+    bool isBatching() const
+    {
+        return available && depth > 0;
+    }
+
+    /** @brief Whether the owner has writes queued or in flight
+     *
+     *  @param[in] owner - the owner, e.g. an LED
+     */
+    bool isPending(const void* owner) const
+    {
+        return chains.contains(owner);
+    }
+
+    /** @brief Queues the writes of an owner as one chain
+     *
+     *  A chain of an owner already in flight is followed by the new one,
+     *  a chain not submitted yet is replaced. Every callback is called
+     *  once: those of a replaced chain, or of one followed by another,
+     *  with the result of the chain whose writes took their place.
+     *  Without io_uring the writes are made right away.
+     *
+     *  @param[in] owner    - the owner
+     *  @param[in] writes   - the writes, in order
+     *  @param[in] complete - called once the chain completed
+     */
+    void enqueue(const void* owner, std::vector<Write> writes,
+                 Complete complete);
+
+    /** @brief Drops the callbacks of the owner, writes in flight finish
+     *
+     *  @param[in] owner - the owner
+     */
+    void cancel(const void* owner);
+
+  private:
+    /** @brief Writes of one owner */
+    struct Chain
+    {
+        const void* owner = nullptr;
+        std::vector<Write> writes;
+
+        /** @brief Callbacks of the chain and of those it replaced */
+        std::vector<Complete> completes;
+
+        /** @brief Result of the first failed write */
+        int rc = 0;
+
+        /** @brief Completions still to be reaped, 0 if not submitted */
+        unsigned inFlight = 0;
+
+        /** @brief Registered file slot the chain opens its files in */
+        unsigned slot = 0;
+
+        /** @brief Chain of the same owner to submit after this one */
+        std::unique_ptr<Chain> next;
+    };
+
+    /** @brief Whether io_uring is set up */
+    bool available = false;
+
+    /** @brief Number of open batches */
+    unsigned depth = 0;
+
+    /** @brief Chains by owner, the one in flight first */
+    std::map<const void*, std::unique_ptr<Chain>> chains;
+
+    /** @brief Chains in flight whose owner was cancelled */
+    std::vector<std::unique_ptr<Chain>> orphans;
+
+    /** @brief Owners with a chain waiting for submission, in order */
+    std::vector<const void*> waiting;
+
+    /** @brief Registered file slots not used by a chain */
+    std::vector<unsigned> freeSlots;
+
+#ifdef LED_SYSFS_URING
+    /** @brief Entries of the submission queue */
+    static constexpr unsigned ringSize = 256;
+
+    /** @brief Files open at a time, one per chain in flight */
+    static constexpr unsigned slotCount = 64;
+
+    io_uring ring{};
+
+    /** @brief Entries the kernel did not take yet and their chains, in
+     *  order, the chain of a no-op is nullptr
+     */
+    std::deque<std::pair<io_uring_sqe*, Chain*>> unsubmitted;
+#endif
+
+    /** @brief Descriptor signalled on completions, -1 if none */
+    int eventFd = -1;
+
+    /** @brief Reaps the completions on the event loop */
+    std::optional<sdeventplus::source::IO> completions;
+
+    void begin();
+
+    void end();
+
+    /** @brief Submits the waiting chains there is room for */
+    void submit();
+
+    /** @brief Reaps the completions and calls back finished chains */
+    void reap();
+
+    /** @brief Retires completed chains, submits the writes queued
+     *  meanwhile and calls back the others
+     *
+     *  @param[in] done - the chains, nothing in flight and their slots
+     *                    freed
+     */
+    void finish(const std::vector<Chain*>& done);
+
+    /** @brief Makes the writes synchronously
+     *
+     *  @param[in] writes - the writes, in order
+     *  @return 0 or the -errno of the first failed write
+     */
+    static int writeNow(const std::vector<Write>& writes);
+};
+
+} // namespace led
+} // namespace phosphor